@@ -5,6 +5,7 @@
 
 #include "brave/browser/extensions/api/brave_shields_api.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/strings/string_number_conversions.h"
@@ -16,10 +17,10 @@
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
-#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/brave_shields_p3a.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/class_id_seen_set.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
@@ -28,10 +29,12 @@
 #include "chrome/browser/extensions/extension_tab_util.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/web_contents.h"
+#include "extensions/browser/extension_api_frame_id_map.h"
 #include "extensions/browser/extension_util.h"
 #include "extensions/common/constants.h"
 
 using brave_shields::BraveShieldsWebContentsObserver;
+using brave_shields::ClassIdSeenSet;
 using brave_shields::ControlType;
 using brave_shields::ControlTypeFromString;
 using brave_shields::ControlTypeToString;
@@ -66,31 +69,16 @@ BraveShieldsUrlCosmeticResourcesFunction::Run() {
 
 std::unique_ptr<base::ListValue> BraveShieldsUrlCosmeticResourcesFunction::
     GetUrlCosmeticResourcesOnTaskRunner(const std::string& url) {
-  base::Optional<base::Value> resources = g_brave_browser_process->
-      ad_block_service()->UrlCosmeticResources(url);
+  base::Optional<::brave_shields::CosmeticResources> resources =
+      g_brave_browser_process->ad_block_service()->MergedUrlCosmeticResources(
+          url);
 
-  if (!resources || !resources->is_dict()) {
+  if (!resources) {
     return std::unique_ptr<base::ListValue>();
   }
 
-  base::Optional<base::Value> regional_resources = g_brave_browser_process->
-      ad_block_regional_service_manager()->UrlCosmeticResources(url);
-
-  if (regional_resources && regional_resources->is_dict()) {
-    ::brave_shields::MergeResourcesInto(
-        std::move(*regional_resources), &*resources, /*force_hide=*/false);
-  }
-
-  base::Optional<base::Value> custom_resources = g_brave_browser_process->
-      ad_block_custom_filters_service()->UrlCosmeticResources(url);
-
-  if (custom_resources && custom_resources->is_dict()) {
-    ::brave_shields::MergeResourcesInto(
-        std::move(*custom_resources), &*resources, /*force_hide=*/true);
-  }
-
   auto result_list = std::make_unique<base::ListValue>();
-  result_list->Append(std::move(*resources));
+  result_list->Append(resources->ToValue());
   return result_list;
 }
 
@@ -108,6 +96,32 @@ BraveShieldsHiddenClassIdSelectorsFunction::Run() {
   std::unique_ptr<brave_shields::HiddenClassIdSelectors::Params> params(
       brave_shields::HiddenClassIdSelectors::Params::Create(*args_));
   EXTENSION_FUNCTION_VALIDATE(params.get());
+
+  content::WebContents* contents = nullptr;
+  if (!ExtensionTabUtil::GetTabById(
+          params->tab_id, Profile::FromBrowserContext(browser_context()),
+          include_incognito_information(), nullptr, nullptr, &contents,
+          nullptr)) {
+    return RespondNow(Error(tabs_constants::kTabNotFoundError,
+                            base::NumberToString(params->tab_id)));
+  }
+
+  // Only look up classes and ids the document has not sent before
+  content::RenderFrameHost* render_frame_host =
+      ExtensionApiFrameIdMap::GetRenderFrameHostById(contents,
+                                                     params->frame_id);
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(contents);
+  if (render_frame_host && observer) {
+    ClassIdSeenSet* seen_set = observer->GetClassIdSeenSet(render_frame_host);
+    if (!seen_set->TakeUnseen(&params->classes, &params->ids)) {
+      return RespondNow(ArgumentList(
+          brave_shields::HiddenClassIdSelectors::Results::Create(
+              std::vector<std::string>(), std::vector<std::string>())));
+    }
+    seen_set_ = seen_set->AsWeakPtr();
+  }
+
   g_brave_browser_process->ad_block_service()->GetTaskRunner()
       ->PostTaskAndReplyWithResult(
           FROM_HERE,
@@ -150,18 +164,35 @@ std::unique_ptr<base::ListValue> BraveShieldsHiddenClassIdSelectorsFunction::
   }
 
   auto result_list = std::make_unique<base::ListValue>();
-  if (hide_selectors && hide_selectors->is_list()) {
-    result_list->Append(std::move(*hide_selectors));
-  }
-  if (custom_selectors && custom_selectors->is_list()) {
-    result_list->Append(std::move(*custom_selectors));
-  }
+  result_list->Append(hide_selectors && hide_selectors->is_list()
+                          ? std::move(*hide_selectors)
+                          : base::Value(base::Value::Type::LIST));
+  result_list->Append(custom_selectors && custom_selectors->is_list()
+                          ? std::move(*custom_selectors)
+                          : base::Value(base::Value::Type::LIST));
 
   return result_list;
 }
 
 void BraveShieldsHiddenClassIdSelectorsFunction::
     GetHiddenClassIdSelectorsOnUI(std::unique_ptr<base::ListValue> selectors) {
+  // The document may have gone away while the selectors were looked up, in
+  // which case they are returned as is.
+  if (seen_set_) {
+    bool force_hide = false;
+    for (base::Value& list : selectors->GetList()) {
+      base::Value::ListStorage& storage = list.GetList();
+      storage.erase(
+          std::remove_if(storage.begin(), storage.end(),
+                         [this, force_hide](const base::Value& selector) {
+                           return !selector.is_string() ||
+                                  !seen_set_->AddSelector(
+                                      selector.GetString(), force_hide);
+                         }),
+          storage.end());
+      force_hide = true;
+    }
+  }
   Respond(ArgumentList(std::move(selectors)));
 }
 
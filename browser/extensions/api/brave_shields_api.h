@@ -10,8 +10,13 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "extensions/browser/extension_function.h"
 
+namespace brave_shields {
+class ClassIdSeenSet;
+}  // namespace brave_shields
+
 namespace extensions {
 namespace api {
 
@@ -46,6 +51,10 @@ class BraveShieldsHiddenClassIdSelectorsFunction : public ExtensionFunction {
       const std::vector<std::string>& exceptions);
   void GetHiddenClassIdSelectorsOnUI(
       std::unique_ptr<base::ListValue> selectors);
+
+  // Selectors already returned to the requesting document are left out of
+  // the response.
+  base::WeakPtr<::brave_shields::ClassIdSeenSet> seen_set_;
 };
 
 class BraveShieldsAllowScriptsOnceFunction : public ExtensionFunction {
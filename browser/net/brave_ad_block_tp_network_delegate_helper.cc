@@ -7,9 +7,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base64url.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/time/time.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
@@ -26,33 +30,19 @@
 
 namespace brave {
 
-void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx) {
-  bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
-  if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly,
-          &ctx->mock_data_url)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly,
-                                       &ctx->mock_data_url)) {
-    ctx->blocked_by = kAdBlocked;
-  } else if (!did_match_exception &&
-             !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
-                                       &ctx->cancel_request_explicitly,
-                                       &ctx->mock_data_url)) {
+namespace {
+
+void ApplyAdBlockDecision(
+    const brave_shields::AdBlockDecisionCache::Decision& decision,
+    BraveRequestInfo* ctx) {
+  if (!decision.should_start_request) {
     ctx->blocked_by = kAdBlocked;
+    ctx->cancel_request_explicitly = decision.cancel_request_explicitly;
+    ctx->mock_data_url = decision.mock_data_url;
   }
 }
 
-void OnShouldBlockAdResult(const ResponseCallback& next_callback,
-                           std::shared_ptr<BraveRequestInfo> ctx) {
+void DispatchAdBlockedEvent(std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
   if (ctx->blocked_by == kAdBlocked) {
     brave_shields::DispatchBlockedEvent(
@@ -60,10 +50,50 @@ void OnShouldBlockAdResult(const ResponseCallback& next_callback,
         ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
         brave_shields::kAds);
   }
+}
+
+}  // namespace
+
+void ShouldBlockAdOnThreadPool(std::shared_ptr<BraveRequestInfo> ctx,
+                               uint64_t generation) {
+  brave_shields::AdBlockService* ad_block_service =
+      g_brave_browser_process->ad_block_service();
+  const std::string tab_host = ctx->tab_origin.host();
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  // Default, regional and custom lists are checked in a single pass so the
+  // request is only prepared once, in that order of precedence
+  std::vector<std::shared_ptr<adblock::Engine>> engines;
+  engines.push_back(ad_block_service->GetEngine());
+  g_brave_browser_process->ad_block_regional_service_manager()->GetEngines(
+      &engines);
+  engines.push_back(
+      g_brave_browser_process->ad_block_custom_filters_service()->GetEngine());
+
+  brave_shields::AdBlockDecisionCache::Decision decision;
+  decision.should_start_request =
+      brave_shields::AdBlockBaseService::ShouldStartRequestWithEngines(
+          engines, ctx->request_url, ctx->resource_type, tab_host,
+          &decision.did_match_exception, &decision.cancel_request_explicitly,
+          &decision.mock_data_url);
+  // A cache hit saves roughly the average of this
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Brave.Shields.AdBlock.MatchTime", base::TimeTicks::Now() - start,
+      base::TimeDelta::FromMicroseconds(1),
+      base::TimeDelta::FromMilliseconds(100), 50);
+  ad_block_service->decision_cache()->Put(
+      ctx->request_url, tab_host, ctx->resource_type, generation, decision);
+
+  ApplyAdBlockDecision(decision, ctx.get());
+}
+
+void OnShouldBlockAdResult(const ResponseCallback& next_callback,
+                           std::shared_ptr<BraveRequestInfo> ctx) {
+  DispatchAdBlockedEvent(ctx);
   next_callback.Run();
 }
 
-void OnBeforeURLRequestAdBlockTP(
+int OnBeforeURLRequestAdBlockTP(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -71,15 +101,34 @@ void OnBeforeURLRequestAdBlockTP(
   // be looked up, so do nothing.
   if (ctx->tab_origin.is_empty() || !ctx->tab_origin.has_host() ||
       ctx->request_url.is_empty()) {
-    return;
+    return net::OK;
   }
   DCHECK_NE(ctx->request_identifier, 0UL);
 
-  g_brave_browser_process->ad_block_service()->GetTaskRunner()
-      ->PostTaskAndReply(FROM_HERE,
-                         base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx),
-                         base::BindOnce(&OnShouldBlockAdResult, next_callback,
-                                        ctx));
+  // Read before any engine snapshot is taken, see GetEngineGeneration()
+  const uint64_t generation =
+      brave_shields::AdBlockBaseService::GetEngineGeneration();
+
+  // Repeated requests are decided right here, without leaving the UI thread
+  brave_shields::AdBlockDecisionCache::Decision decision;
+  const bool cached =
+      g_brave_browser_process->ad_block_service()->decision_cache()->Get(
+          ctx->request_url, ctx->tab_origin.host(), ctx->resource_type,
+          generation, &decision);
+  UMA_HISTOGRAM_BOOLEAN("Brave.Shields.AdBlock.DecisionCacheHit", cached);
+  if (cached) {
+    ApplyAdBlockDecision(decision, ctx.get());
+    DispatchAdBlockedEvent(ctx);
+    return net::OK;
+  }
+
+  // Engines are immutable snapshots, so requests are matched concurrently
+  // rather than queued on the ad block task runner
+  base::PostTaskAndReply(
+      FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&ShouldBlockAdOnThreadPool, ctx, generation),
+      base::BindOnce(&OnShouldBlockAdResult, next_callback, ctx));
+  return net::ERR_IO_PENDING;
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(
@@ -98,9 +147,7 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
     return net::OK;
   }
 
-  OnBeforeURLRequestAdBlockTP(next_callback, ctx);
-
-  return net::ERR_IO_PENDING;
+  return OnBeforeURLRequestAdBlockTP(next_callback, ctx);
 }
 
 }  // namespace brave
@@ -25,9 +25,8 @@ void OnBeforeURLRequest_HttpseFileWork(
     std::shared_ptr<BraveRequestInfo> ctx) {
   base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
                                                 base::BlockingType::WILL_BLOCK);
-  DCHECK_NE(ctx->request_identifier, 0U);
   g_brave_browser_process->https_everywhere_service()->
-    GetHTTPSURL(&ctx->request_url, ctx->request_identifier, &ctx->new_url_spec);
+    GetHTTPSURL(&ctx->request_url, &ctx->new_url_spec);
 }
 
 void OnBeforeURLRequest_HttpsePostFileWork(
@@ -37,6 +36,7 @@ void OnBeforeURLRequest_HttpsePostFileWork(
 
   if (!ctx->new_url_spec.empty() &&
     ctx->new_url_spec != ctx->request_url.spec()) {
+    ctx->httpse_redirects_count++;
     brave_shields::DispatchBlockedEvent(ctx->request_url,
         ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
         brave_shields::kHTTPUpgradableResources);
@@ -60,6 +60,11 @@ int OnBeforeURLRequest_HttpsePreFileWork(
     return net::OK;
   }
 
+  if (!brave_shields::HTTPSEverywhereService::ShouldHTTPSERedirect(
+          ctx->httpse_redirects_count)) {
+    return net::OK;
+  }
+
   bool is_valid_url = true;
   is_valid_url = ctx->request_url.is_valid();
   std::string scheme = ctx->request_url.scheme();
@@ -72,9 +77,7 @@ int OnBeforeURLRequest_HttpsePreFileWork(
 
   if (is_valid_url) {
     if (!g_brave_browser_process->https_everywhere_service()->
-        GetHTTPSURLFromCacheOnly(&ctx->request_url,
-                                 ctx->request_identifier,
-                                 &ctx->new_url_spec)) {
+        GetHTTPSURLFromCacheOnly(&ctx->request_url, &ctx->new_url_spec)) {
       g_brave_browser_process->https_everywhere_service()->
         GetTaskRunner()->PostTaskAndReply(FROM_HERE,
           base::Bind(OnBeforeURLRequest_HttpseFileWork, ctx),
@@ -84,6 +87,7 @@ int OnBeforeURLRequest_HttpsePreFileWork(
       return net::ERR_IO_PENDING;
     } else {
       if (!ctx->new_url_spec.empty()) {
+        ctx->httpse_redirects_count++;
         brave_shields::DispatchBlockedEvent(ctx->request_url,
             ctx->render_frame_id, ctx->render_process_id,
             ctx->frame_tree_node_id,
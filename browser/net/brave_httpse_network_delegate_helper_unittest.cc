@@ -53,4 +53,17 @@ TEST_F(BraveHTTPSENetworkDelegateHelperTest, AlreadySetNewURLNoOp) {
   EXPECT_EQ(ret, net::OK);
 }
 
+TEST_F(BraveHTTPSENetworkDelegateHelperTest, RedirectLimitNoOp) {
+  GURL url("http://bradhatesprimes.brave.com/composite_numbers_ftw");
+  std::shared_ptr<brave::BraveRequestInfo>
+      brave_request_info(new brave::BraveRequestInfo(url));
+  brave_request_info->tab_origin = GURL("http://brad.brave.com/");
+  brave_request_info->httpse_redirects_count = 4;
+  brave::ResponseCallback callback;
+  int ret =
+    OnBeforeURLRequest_HttpsePreFileWork(callback, brave_request_info);
+  EXPECT_TRUE(brave_request_info->new_url_spec.empty());
+  EXPECT_EQ(ret, net::OK);
+}
+
 }  // namespace
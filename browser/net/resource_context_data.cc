@@ -11,6 +11,8 @@
 #include "brave/browser/net/brave_proxying_url_loader_factory.h"
 #include "brave/browser/net/brave_proxying_web_socket.h"
 #include "brave/browser/net/brave_request_handler.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_context.h"
 #include "net/cookies/site_for_cookies.h"
 
@@ -106,6 +108,27 @@ BraveProxyingWebSocket* ResourceContextData::StartProxyingWebSocket(
   return raw_proxy;
 }
 
+// static
+brave_shields::ShieldsSettingsSnapshot ResourceContextData::GetShieldsSettings(
+    content::BrowserContext* browser_context,
+    const GURL& tab_origin,
+    bool is_navigation) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  auto* map = HostContentSettingsMapFactory::GetForProfile(
+      Profile::FromBrowserContext(browser_context));
+
+  auto* self = static_cast<ResourceContextData*>(
+      browser_context->GetUserData(kResourceContextUserDataKey));
+  if (!self) {
+    return brave_shields::ShieldsSettingsSnapshot::Create(map, tab_origin);
+  }
+
+  if (!self->shields_settings_cache_) {
+    self->shields_settings_cache_ =
+        std::make_unique<brave_shields::ShieldsSettingsSnapshotCache>(map);
+  }
+  return self->shields_settings_cache_->Get(tab_origin, is_navigation);
+}
 
 void ResourceContextData::RemoveProxy(BraveProxyingURLLoaderFactory* proxy) {
   auto it = proxies_.find(proxy);
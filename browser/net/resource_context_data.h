@@ -15,6 +15,7 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/supports_user_data.h"
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/content_browser_client.h"
 #include "services/network/public/mojom/url_loader_factory.mojom.h"
@@ -75,6 +76,14 @@ class ResourceContextData : public base::SupportsUserData::Data {
       int frame_tree_node_id,
       const url::Origin& origin);
 
+  // Returns the shields settings for requests made by |tab_origin|, read
+  // from content settings only when a navigation or a settings change asks
+  // for it.
+  static brave_shields::ShieldsSettingsSnapshot GetShieldsSettings(
+      content::BrowserContext* browser_context,
+      const GURL& tab_origin,
+      bool is_navigation);
+
   void RemoveProxy(BraveProxyingURLLoaderFactory* proxy);
   void RemoveProxyWebSocket(BraveProxyingWebSocket* proxy);
 
@@ -83,6 +92,8 @@ class ResourceContextData : public base::SupportsUserData::Data {
 
   std::unique_ptr<BraveRequestHandler> request_handler_;
   scoped_refptr<RequestIDGenerator> request_id_generator_;
+  std::unique_ptr<brave_shields::ShieldsSettingsSnapshotCache>
+      shields_settings_cache_;
 
   std::set<std::unique_ptr<BraveProxyingURLLoaderFactory>,
            base::UniquePtrComparator>
@@ -8,13 +8,12 @@
 #include <memory>
 #include <string>
 
-#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/browser/net/resource_context_data.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "brave/components/ipfs/browser/buildflags/buildflags.h"
-#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
-#include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
 
@@ -108,15 +107,24 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                               .GetOrigin();
   }
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(
-      map, ctx->tab_origin) == brave_shields::ControlType::ALLOW;
-  ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
-  ctx->allow_referrers = brave_shields::AllowReferrers(map, ctx->tab_origin);
+  if (old_ctx && old_ctx->tab_origin == ctx->tab_origin) {
+    // A later stage of the same request, nothing to look up again
+    ctx->allow_brave_shields = old_ctx->allow_brave_shields;
+    ctx->allow_ads = old_ctx->allow_ads;
+    ctx->allow_http_upgradable_resource =
+        old_ctx->allow_http_upgradable_resource;
+    ctx->allow_referrers = old_ctx->allow_referrers;
+  } else {
+    const brave_shields::ShieldsSettingsSnapshot shields_settings =
+        ResourceContextData::GetShieldsSettings(
+            browser_context, ctx->tab_origin,
+            ctx->resource_type == blink::mojom::ResourceType::kMainFrame);
+    ctx->allow_brave_shields = shields_settings.brave_shields_enabled;
+    ctx->allow_ads = shields_settings.allow_ads;
+    ctx->allow_http_upgradable_resource =
+        !shields_settings.https_everywhere_enabled;
+    ctx->allow_referrers = shields_settings.allow_referrers;
+  }
   ctx->upload_data = GetUploadData(request);
 
 #if BUILDFLAG(IPFS_ENABLED)
@@ -132,6 +140,7 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
   if (old_ctx) {
     ctx->internal_redirect = old_ctx->internal_redirect;
     ctx->redirect_source = old_ctx->redirect_source;
+    ctx->httpse_redirects_count = old_ctx->httpse_redirects_count;
   }
 }
 
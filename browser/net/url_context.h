@@ -63,6 +63,9 @@ struct BraveRequestInfo {
 
   bool internal_redirect = false;
   GURL redirect_source;
+  // Number of HTTPS Everywhere upgrades applied across the request's
+  // redirect chain.
+  int httpse_redirects_count = 0;
 
   GURL referrer;
   net::ReferrerPolicy referrer_policy =
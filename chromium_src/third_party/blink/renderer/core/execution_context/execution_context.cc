@@ -7,6 +7,7 @@
 
 #include "base/command_line.h"
 #include "base/strings/string_number_conversions.h"
+#include "build/build_config.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
@@ -22,6 +23,10 @@
 #include "third_party/blink/renderer/platform/network/network_utils.h"
 #include "third_party/blink/renderer/platform/supplementable.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
 namespace {
 
 const uint64_t zero = 0;
@@ -30,32 +35,96 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
-}
-
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
+// returns pseudo-random float between 0 and 0.1 for a PRNG state
+inline float PseudoRandomSample(uint64_t v) {
+  const double maxUInt64AsDouble = UINT64_MAX;
+  return (v / maxUInt64AsDouble) / 10;
 }
 
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
+void MultiplySamples(double fudge_factor, float* samples, size_t count) {
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  // Multiplying in double precision, as the scalar loop below does, keeps
+  // the results identical whichever path a sample goes through.
+  const __m128d fudge = _mm_set1_pd(fudge_factor);
+  for (; i + 4 <= count; i += 4) {
+    const __m128 values = _mm_loadu_ps(samples + i);
+    const __m128d low = _mm_mul_pd(_mm_cvtps_pd(values), fudge);
+    const __m128d high =
+        _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(values, values)), fudge);
+    _mm_storeu_ps(samples + i,
+                  _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high)));
+  }
+#endif
+  for (; i < count; ++i) {
+    samples[i] = samples[i] * fudge_factor;
   }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
 }
 
 }  // namespace
 
 namespace brave {
 
+AudioFarbler::AudioFarbler()
+    : mode_(Mode::kNone), fudge_factor_(1), seed_(0) {}
+
+// static
+AudioFarbler AudioFarbler::ConstantMultiplier(double fudge_factor) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kConstantMultiplier;
+  farbler.fudge_factor_ = fudge_factor;
+  return farbler;
+}
+
+// static
+AudioFarbler AudioFarbler::PseudoRandomSequence(uint64_t seed) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kPseudoRandomSequence;
+  farbler.seed_ = seed;
+  return farbler;
+}
+
+void AudioFarbler::Farble(float* samples, size_t count) const {
+  switch (mode_) {
+    case Mode::kNone:
+      break;
+    case Mode::kConstantMultiplier:
+      MultiplySamples(fudge_factor_, samples, count);
+      break;
+    case Mode::kPseudoRandomSequence: {
+      // the noise does not depend on the samples, so it is written out
+      // directly with the PRNG state kept local to this run
+      uint64_t v = seed_;
+      for (size_t i = 0; i < count; ++i) {
+        v = lfsr_next(v);
+        samples[i] = PseudoRandomSample(v);
+      }
+      break;
+    }
+  }
+}
+
+float AudioFarbler::FarbleSample(float value,
+                                 size_t index,
+                                 uint64_t* state) const {
+  switch (mode_) {
+    case Mode::kNone:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence:
+      if (index == 0) {
+        // start of loop, reset to initial seed which is based on the domain
+        // key
+        *state = seed_;
+      }
+      *state = lfsr_next(*state);
+      return PseudoRandomSample(*state);
+  }
+  NOTREACHED();
+  return value;
+}
+
 const char kBraveSessionToken[] = "brave_session_token";
 const char BraveSessionCache::kSupplementName[] = "BraveSessionCache";
 
@@ -120,7 +189,7 @@ BraveSessionCache& BraveSessionCache::From(ExecutionContext& context) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
+AudioFarbler BraveSessionCache::GetAudioFarbler(
     blink::WebContentSettingsClient* settings) {
   if (farbling_enabled_ && settings) {
     switch (settings->GetBraveFarblingLevel()) {
@@ -133,15 +202,15 @@ AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
         double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
         VLOG(1) << "audio fudge factor (based on session token) = "
                 << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
+        return AudioFarbler::ConstantMultiplier(fudge_factor);
       }
       case BraveFarblingLevel::MAXIMUM: {
         uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
+        return AudioFarbler::PseudoRandomSequence(seed);
       }
     }
   }
-  return base::BindRepeating(&Identity);
+  return AudioFarbler();
 }
 
 scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
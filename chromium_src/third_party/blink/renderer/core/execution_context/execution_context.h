@@ -10,8 +10,6 @@
 
 #include <random>
 
-#include "base/callback.h"
-
 namespace blink {
 class StaticBitmapImage;
 class WebContentSettingsClient;
@@ -27,7 +25,34 @@ using blink::TraceTrait;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Applies the audio farbling chosen for a context to its sample data. It
+// keeps no sequence state of its own, so copies held by different audio
+// contexts and worklets never affect each other.
+class CORE_EXPORT AudioFarbler {
+ public:
+  // Leaves samples untouched.
+  AudioFarbler();
+
+  static AudioFarbler ConstantMultiplier(double fudge_factor);
+  static AudioFarbler PseudoRandomSequence(uint64_t seed);
+
+  explicit operator bool() const { return mode_ != Mode::kNone; }
+
+  // Farbles |count| samples in place as a single run, restarting the
+  // pseudo-random sequence from its seed.
+  void Farble(float* samples, size_t count) const;
+  // Farbles one sample, for loops that keep transforming each value.
+  // |state| carries the pseudo-random sequence between indexes and is reset
+  // when |index| is 0.
+  float FarbleSample(float value, size_t index, uint64_t* state) const;
+
+ private:
+  enum class Mode { kNone, kConstantMultiplier, kPseudoRandomSequence };
+
+  Mode mode_;
+  double fudge_factor_;
+  uint64_t seed_;
+};
 
 CORE_EXPORT blink::WebContentSettingsClient* GetContentSettingsClientFor(
     ExecutionContext* context);
@@ -43,8 +68,7 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(ExecutionContext&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(
-      blink::WebContentSettingsClient* settings);
+  AudioFarbler GetAudioFarbler(blink::WebContentSettingsClient* settings);
   scoped_refptr<blink::StaticBitmapImage> PerturbPixels(
       blink::WebContentSettingsClient* settings,
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
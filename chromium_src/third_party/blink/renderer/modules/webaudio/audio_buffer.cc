@@ -3,7 +3,6 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
-#include "base/callback.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "third_party/blink/public/platform/web_content_settings_client.h"
 #include "third_party/blink/renderer/core/dom/document.h"
@@ -21,13 +20,9 @@
       DOMFloat32Array* destination_array = array.View();                       \
       size_t len = destination_array->lengthAsSizeT();                         \
       if (len > 0) {                                                           \
-        float* destination = destination_array->Data();                        \
-        brave::AudioFarblingCallback audio_farbling_callback =                 \
-            brave::BraveSessionCache::From(*context).GetAudioFarblingCallback( \
-                settings);                                                     \
-        for (unsigned i = 0; i < len; ++i) {                                   \
-          destination[i] = audio_farbling_callback.Run(destination[i], i);     \
-        }                                                                      \
+        brave::BraveSessionCache::From(*context)                               \
+            .GetAudioFarbler(settings)                                         \
+            .Farble(destination_array->Data(), len);                           \
       }                                                                        \
     }                                                                          \
   }
@@ -36,12 +31,9 @@
   if (ExecutionContext* context = ExecutionContext::From(script_state)) {    \
     if (WebContentSettingsClient* settings =                                 \
             brave::GetContentSettingsClientFor(context)) {                   \
-      brave::AudioFarblingCallback audio_farbling_callback =                 \
-          brave::BraveSessionCache::From(*context).GetAudioFarblingCallback( \
-              settings);                                                     \
-      for (unsigned i = 0; i < count; i++) {                                 \
-        dst[i] = audio_farbling_callback.Run(dst[i], i);                     \
-      }                                                                      \
+      brave::BraveSessionCache::From(*context)                               \
+          .GetAudioFarbler(settings)                                         \
+          .Farble(dst, count);                                               \
     }                                                                        \
   }
 
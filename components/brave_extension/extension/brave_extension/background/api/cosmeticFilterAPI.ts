@@ -18,8 +18,8 @@ const informTabOfCosmeticRulesToConsider = (tabId: number, selectors: string[])
 }
 
 // Fires when content-script calls hiddenClassIdSelectors
-export const injectClassIdStylesheet = (tabId: number, classes: string[], ids: string[], exceptions: string[], hide1pContent: boolean) => {
-  chrome.braveShields.hiddenClassIdSelectors(classes, ids, exceptions, (selectors, forceHideSelectors) => {
+export const injectClassIdStylesheet = (tabId: number, frameId: number, classes: string[], ids: string[], exceptions: string[], hide1pContent: boolean) => {
+  chrome.braveShields.hiddenClassIdSelectors(tabId, frameId, classes, ids, exceptions, (selectors, forceHideSelectors) => {
     if (hide1pContent) {
       forceHideSelectors.push(...selectors)
     } else {
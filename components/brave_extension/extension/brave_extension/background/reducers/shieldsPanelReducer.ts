@@ -373,7 +373,7 @@ export default function shieldsPanelReducer (
 
       // setTimeout is used to prevent injectClassIdStylesheet from calling
       // another Redux function immediately
-      setTimeout(() => injectClassIdStylesheet(action.tabId, action.classes, action.ids, exceptions, hide1pContent), 0)
+      setTimeout(() => injectClassIdStylesheet(action.tabId, action.frameId, action.classes, action.ids, exceptions, hide1pContent), 0)
       break
     }
     case shieldsPanelTypes.COSMETIC_FILTER_RULE_EXCEPTIONS: {
@@ -176,12 +176,13 @@ export interface ShieldsReady {
 interface GenerateClassIdStylesheetReturn {
   type: types.GENERATE_CLASS_ID_STYLESHEET,
   tabId: number,
+  frameId: number,
   classes: string[],
   ids: string[]
 }
 
 export interface GenerateClassIdStylesheet {
-  (tabId: number, classes: string[], ids: string[]): GenerateClassIdStylesheetReturn
+  (tabId: number, frameId: number, classes: string[], ids: string[]): GenerateClassIdStylesheetReturn
 }
 
 interface CosmeticFilterRuleExceptionsReturn {
@@ -17,6 +17,7 @@
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/files/important_file_writer.h"
 #include "base/i18n/time_formatting.h"
@@ -107,8 +108,26 @@ namespace {
 const int kDiagnosticLogMaxVerboseLevel = 6;
 const int kTailDiagnosticLogToNumLines = 20000;
 const int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
+// Log entries are buffered and written to disk in one go, either after
+// kDiagnosticLogFlushDelay or once the buffer reaches kDiagnosticLogFlushSize
+constexpr base::TimeDelta kDiagnosticLogFlushDelay =
+    base::TimeDelta::FromSeconds(1);
+const size_t kDiagnosticLogFlushSize = 64 * 1024;
 const char pref_prefix[] = "brave.rewards";
 
+// Used for the final flush at shutdown, when the service can be gone before
+// the file task runner gets to the write
+void AppendToDiagnosticLog(
+    const base::FilePath& path,
+    const std::string& log_entries) {
+  base::File file(path,
+      base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  if (!file.IsValid() || !WriteToLog(&file, log_entries)) {
+    VLOG(0) << "Failed to write to diagnostic log: "
+        << base::File::ErrorToString(file.error_details());
+  }
+}
+
 std::string URLMethodToRequestType(ledger::type::UrlMethod method) {
   switch (method) {
     case ledger::type::UrlMethod::GET:
@@ -832,6 +851,19 @@ void RewardsServiceImpl::Shutdown() {
   url_loaders_.clear();
 
   bat_ledger_.reset();
+
+  // Buffered entries would be lost with the flush timer. The file task
+  // runner blocks shutdown, so the write completes before the browser exits
+  diagnostic_log_flush_timer_.Stop();
+  if (!pending_diagnostic_log_.empty()) {
+    std::string log_entries;
+    log_entries.swap(pending_diagnostic_log_);
+    file_task_runner_->PostTask(FROM_HERE,
+        base::BindOnce(&AppendToDiagnosticLog,
+            diagnostic_log_path_,
+            std::move(log_entries)));
+  }
+
   RewardsService::Shutdown();
 }
 
@@ -1069,7 +1101,10 @@ void RewardsServiceImpl::OnURLLoaderComplete(
   std::unique_ptr<network::SimpleURLLoader> scoped_loader(loader);
 
   ledger::type::UrlResponse response;
-  response.body = response_body ? *response_body : "";
+  if (response_body) {
+    // bodies like the publisher prefix list are large, don't copy them
+    response.body = std::move(*response_body);
+  }
 
   if (loader->NetError() != net::OK) {
     response.error = net::ErrorToString(loader->NetError());
@@ -1431,6 +1466,7 @@ void RewardsServiceImpl::OnStopLedgerForCompleteReset(
     SuccessCallback callback,
     const ledger::type::Result result) {
   profile_->GetPrefs()->ClearPrefsWithPrefixSilently(pref_prefix);
+  DiscardPendingDiagnosticLog();
 
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
@@ -1452,6 +1488,8 @@ bool RewardsServiceImpl::ResetOnFilesTaskRunner() {
     ledger_state_path_,
     publisher_state_path_,
     publisher_info_db_path_,
+    base::FilePath(publisher_info_db_path_.value() + FILE_PATH_LITERAL("-wal")),
+    base::FilePath(publisher_info_db_path_.value() + FILE_PATH_LITERAL("-shm")),
     diagnostic_log_path_,
     publisher_list_path_,
   };
@@ -2286,26 +2324,50 @@ void RewardsServiceImpl::DiagnosticLog(
     return;
   }
 
+  pending_diagnostic_log_ += FriendlyFormatLogEntry(
+      base::Time::Now(), file, line, verbose_level, message);
+
+  if (pending_diagnostic_log_.size() >= kDiagnosticLogFlushSize) {
+    FlushDiagnosticLog();
+    return;
+  }
+
+  if (!diagnostic_log_flush_timer_.IsRunning()) {
+    diagnostic_log_flush_timer_.Start(FROM_HERE, kDiagnosticLogFlushDelay,
+        base::BindOnce(&RewardsServiceImpl::FlushDiagnosticLog,
+            base::Unretained(this)));
+  }
+}
+
+void RewardsServiceImpl::FlushDiagnosticLog() {
+  diagnostic_log_flush_timer_.Stop();
+
+  if (pending_diagnostic_log_.empty()) {
+    return;
+  }
+
+  std::string log_entries;
+  log_entries.swap(pending_diagnostic_log_);
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
           diagnostic_log_path_,
           kTailDiagnosticLogToNumLines,
-          file,
-          line,
-          verbose_level,
-          message),
+          std::move(log_entries)),
       base::BindOnce(&RewardsServiceImpl::OnWriteToLogOnFileTaskRunner,
           AsWeakPtr()));
 }
 
+void RewardsServiceImpl::DiscardPendingDiagnosticLog() {
+  diagnostic_log_flush_timer_.Stop();
+  pending_diagnostic_log_.clear();
+}
+
 bool RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner(
     const base::FilePath& log_path,
     const int num_lines,
-    const std::string& file,
-    const int line,
-    const int verbose_level,
-    const std::string& message) {
+    const std::string& log_entries) {
   if (!InitializeLog(&diagnostic_log_, log_path)) {
     VLOG(0) << "Failed to initialize diagnostic log: "
         << GetLastFileError(&diagnostic_log_);
@@ -2313,12 +2375,7 @@ bool RewardsServiceImpl::WriteToDiagnosticLogOnFileTaskRunner(
     return false;
   }
 
-  const base::Time time = base::Time::Now();
-
-  const std::string log_entry =
-      FriendlyFormatLogEntry(time, file, line, verbose_level, message);
-
-  if (!WriteToLog(&diagnostic_log_, log_entry)) {
+  if (!WriteToLog(&diagnostic_log_, log_entries)) {
     VLOG(0) << "Failed to write to diagnostic log: "
         << GetLastFileError(&diagnostic_log_);
 
@@ -2342,6 +2399,8 @@ void RewardsServiceImpl::OnWriteToLogOnFileTaskRunner(
 void RewardsServiceImpl::LoadDiagnosticLog(
       const int num_lines,
       LoadDiagnosticLogCallback callback) {
+  FlushDiagnosticLog();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::LoadDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
@@ -2376,6 +2435,8 @@ void RewardsServiceImpl::OnLoadDiagnosticLogOnFileTaskRunner(
 
 void RewardsServiceImpl::ClearDiagnosticLog(
     ClearDiagnosticLogCallback callback) {
+  DiscardPendingDiagnosticLog();
+
   base::PostTaskAndReplyWithResult(file_task_runner_.get(), FROM_HERE,
       base::BindOnce(&RewardsServiceImpl::ClearDiagnosticLogOnFileTaskRunner,
           base::Unretained(this),
@@ -2493,6 +2554,17 @@ void RewardsServiceImpl::HandleFlags(const std::string& options) {
       SetShortRetries(short_retries);
     }
 
+    if (name == "queue-concurrency") {
+      int concurrency;
+      bool success = base::StringToInt(value, &concurrency);
+
+      if (success && concurrency > 0) {
+        SetContributionQueueConcurrency(concurrency);
+      }
+
+      continue;
+    }
+
     if (name == "development") {
       ledger::type::Environment environment;
       std::string lower = base::ToLowerASCII(value);
@@ -2594,6 +2666,8 @@ void RewardsServiceImpl::PrepareLedgerEnvForTesting() {
 
   bat_ledger_service_->SetTesting();
 
+  // Written before the ledger is initialized, at which point its state
+  // cache is dropped
   profile_->GetPrefs()->SetInteger(prefs::kMinVisitTime, 1);
   SetShortRetries(true);
 
@@ -2653,6 +2727,11 @@ void RewardsServiceImpl::SetShortRetries(bool short_retries) {
   bat_ledger_service_->SetShortRetries(short_retries);
 }
 
+void RewardsServiceImpl::SetContributionQueueConcurrency(
+    const int32_t concurrency) {
+  bat_ledger_service_->SetContributionQueueConcurrency(concurrency);
+}
+
 void RewardsServiceImpl::GetPendingContributionsTotal(
     const GetPendingContributionsTotalCallback& callback) {
   if (!Connected()) {
@@ -3369,6 +3448,7 @@ void RewardsServiceImpl::WalletDisconnected(const std::string& wallet_type) {
 }
 
 void RewardsServiceImpl::DeleteLog(ledger::ResultCallback callback) {
+  DiscardPendingDiagnosticLog();
   diagnostic_log_.Close();
   base::PostTaskAndReplyWithResult(
       file_task_runner_.get(),
@@ -19,6 +19,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/one_shot_event.h"
+#include "base/timer/timer.h"
 #include "base/values.h"
 #include "bat/ledger/ledger.h"
 #include "bat/ledger/ledger_client.h"
@@ -39,8 +40,6 @@
 #endif
 
 namespace base {
-class OneShotTimer;
-class RepeatingTimer;
 class SequencedTaskRunner;
 }  // namespace base
 
@@ -204,6 +203,7 @@ class RewardsServiceImpl : public RewardsService,
   void SetReconcileInterval(const int32_t interval);
   void GetReconcileInterval(GetReconcileIntervalCallback callback);
   void SetShortRetries(bool short_retries);
+  void SetContributionQueueConcurrency(const int32_t concurrency);
   void GetShortRetries(const GetShortRetriesCallback& callback);
 
   void GetAutoContributeProperties(
@@ -557,13 +557,14 @@ class RewardsServiceImpl : public RewardsService,
       const int verbose_level,
       const std::string& message) override;
 
+  void FlushDiagnosticLog();
+
+  void DiscardPendingDiagnosticLog();
+
   bool WriteToDiagnosticLogOnFileTaskRunner(
       const base::FilePath& log_path,
       const int num_lines,
-      const std::string& file,
-      const int line,
-      const int verbose_level,
-      const std::string& message);
+      const std::string& log_entries);
 
   void OnWriteToLogOnFileTaskRunner(
     const bool success);
@@ -753,6 +754,9 @@ class RewardsServiceImpl : public RewardsService,
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   const base::FilePath diagnostic_log_path_;
   base::File diagnostic_log_;
+  // Formatted log entries that are not yet written to |diagnostic_log_|
+  std::string pending_diagnostic_log_;
+  base::OneShotTimer diagnostic_log_flush_timer_;
   const base::FilePath ledger_state_path_;
   const base::FilePath publisher_state_path_;
   const base::FilePath publisher_info_db_path_;
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/files/file_path.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
@@ -104,13 +105,35 @@ std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
 
 namespace brave_shields {
 
+std::atomic<uint64_t> AdBlockBaseService::engine_generation_(0);
+
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
+      rebuild_engine_pending_(false),
       ad_block_client_(new adblock::Engine()),
       weak_factory_(this) {}
 
 AdBlockBaseService::~AdBlockBaseService() {
-  GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
+  // Matching may still hold a reference, the engine goes away with the last
+  GetTaskRunner()->PostTask(
+      FROM_HERE,
+      base::BindOnce(base::DoNothing::Once<std::shared_ptr<adblock::Engine>>(),
+                     std::move(ad_block_client_)));
+}
+
+std::shared_ptr<adblock::Engine> AdBlockBaseService::GetEngine() {
+  base::AutoLock lock(ad_block_client_lock_);
+  return ad_block_client_;
+}
+
+// static
+uint64_t AdBlockBaseService::GetEngineGeneration() {
+  return engine_generation_.load(std::memory_order_acquire);
+}
+
+// static
+void AdBlockBaseService::AdvanceEngineGeneration() {
+  engine_generation_.fetch_add(1, std::memory_order_release);
 }
 
 bool AdBlockBaseService::ShouldStartRequest(
@@ -120,37 +143,63 @@ bool AdBlockBaseService::ShouldStartRequest(
     bool* did_match_exception,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  return ShouldStartRequestWithEngines(
+      {GetEngine()}, url, resource_type, tab_host, did_match_exception,
+      cancel_request_explicitly, mock_data_url);
+}
 
+// static
+bool AdBlockBaseService::ShouldStartRequestWithEngines(
+    const std::vector<std::shared_ptr<adblock::Engine>>& engines,
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool* did_match_exception,
+    bool* cancel_request_explicitly,
+    std::string* mock_data_url) {
+  if (did_match_exception) {
+    *did_match_exception = false;
+  }
+  if (engines.empty()) {
+    return true;
+  }
+
+  // The request properties are the same for every list, so work them out
+  // once rather than per engine.
   // Determine third-party here so the library doesn't need to figure it out.
   // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
   // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
+  const bool is_third_party = !SameDomainOrHost(
       url,
       url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
       INCLUDE_PRIVATE_REGISTRIES);
-  bool explicit_cancel;
-  bool saved_from_exception;
-  if (ad_block_client_->matches(
-          url.spec(), url.host(), tab_host, is_third_party,
-          ResourceTypeToString(resource_type), &explicit_cancel,
-          &saved_from_exception, mock_data_url)) {
-    if (cancel_request_explicitly) {
-      *cancel_request_explicitly = explicit_cancel;
-    }
-    // We'd only possibly match an exception filter if we're returning true.
-    if (did_match_exception) {
-      *did_match_exception = false;
+  const std::string& spec = url.spec();
+  const std::string host = url.host();
+  const std::string filter_option = ResourceTypeToString(resource_type);
+
+  for (const auto& engine : engines) {
+    bool explicit_cancel;
+    bool saved_from_exception;
+    if (engine->matches(spec, host, tab_host, is_third_party, filter_option,
+                        &explicit_cancel, &saved_from_exception,
+                        mock_data_url)) {
+      if (cancel_request_explicitly) {
+        *cancel_request_explicitly = explicit_cancel;
+      }
+      // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
+      //  << tab_host
+      //  << ", resource type: " << resource_type
+      //  << ", url.spec(): " << url.spec();
+      return false;
     }
-    // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
-    return false;
-  }
 
-  if (did_match_exception) {
-    *did_match_exception = saved_from_exception;
+    // An exception filter allows the request regardless of later lists
+    if (saved_from_exception) {
+      if (did_match_exception) {
+        *did_match_exception = true;
+      }
+      return true;
+    }
   }
 
   return true;
@@ -164,17 +213,18 @@ void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
     return;
   }
 
+  std::vector<std::string>::iterator it =
+      std::find(tags_.begin(), tags_.end(), tag);
+  if (enabled == (it != tags_.end())) {
+    return;
+  }
+
   if (enabled) {
-    ad_block_client_->addTag(tag);
     tags_.push_back(tag);
   } else {
-    ad_block_client_->removeTag(tag);
-    std::vector<std::string>::iterator it =
-        std::find(tags_.begin(), tags_.end(), tag);
-    if (it != tags_.end()) {
-      tags_.erase(it);
-    }
+    tags_.erase(it);
   }
+  ScheduleRebuildEngine();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
@@ -185,18 +235,27 @@ void AdBlockBaseService::AddResources(const std::string& resources) {
     return;
   }
 
-  ad_block_client_->addResources(resources);
+  if (resources == resources_) {
+    return;
+  }
+
   resources_ = resources;
+  ScheduleRebuildEngine();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
-base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
+base::Optional<CosmeticResources> AdBlockBaseService::UrlCosmeticResources(
         const std::string& url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  base::Optional<base::Value> value =
+      base::JSONReader::Read(GetEngine()->urlCosmeticResources(url));
+  if (!value) {
+    return base::nullopt;
+  }
+  return CosmeticResources::FromValue(*value);
 }
 
 base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
@@ -205,7 +264,7 @@ base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& exceptions) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
   return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+      GetEngine()->hiddenClassIdSelectors(classes, ids, exceptions));
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
@@ -214,10 +273,11 @@ void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
       base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
                      dat_file_path),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), dat_file_path));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
+void AdBlockBaseService::OnGetDATFileData(const base::FilePath& dat_file_path,
+                                          GetDATFileDataResult result) {
   if (result.second.empty()) {
     LOG(ERROR) << "Could not obtain ad block data";
     return;
@@ -228,25 +288,90 @@ void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
   }
   GetTaskRunner()->PostTask(
       FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
+                                base::Unretained(this), dat_file_path,
                                 std::move(result.first)));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
+    const base::FilePath& dat_file_path,
     std::unique_ptr<adblock::Engine> ad_block_client) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_ = std::move(ad_block_client);
-  AddKnownTagsToAdBlockInstance();
-  AddKnownResourcesToAdBlockInstance();
+  dat_file_path_ = dat_file_path;
+  rules_.clear();
+  PublishEngine(std::move(ad_block_client));
 }
 
-void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
-  std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+void AdBlockBaseService::UpdateRules(const std::string& rules) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  dat_file_path_.clear();
+  rules_ = rules;
+  RebuildEngine();
+}
+
+std::unique_ptr<adblock::Engine> AdBlockBaseService::CreateEngine() {
+  if (!dat_file_path_.empty()) {
+    GetDATFileDataResult result =
+        brave_component_updater::LoadDATFileData<adblock::Engine>(
+            dat_file_path_);
+    if (!result.first.get()) {
+      LOG(ERROR) << "Failed to reload ad block data";
+    }
+    return std::move(result.first);
+  }
+
+  if (rules_.empty()) {
+    return std::make_unique<adblock::Engine>();
+  }
+  return std::make_unique<adblock::Engine>(rules_);
+}
+
+void AdBlockBaseService::RebuildEngine() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  std::unique_ptr<adblock::Engine> ad_block_client = CreateEngine();
+  if (!ad_block_client) {
+    return;
+  }
+  PublishEngine(std::move(ad_block_client));
 }
 
-void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+void AdBlockBaseService::ScheduleRebuildEngine() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  if (rebuild_engine_pending_) {
+    return;
+  }
+
+  rebuild_engine_pending_ = true;
+  GetTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(&AdBlockBaseService::OnScheduledRebuildEngine,
+                                base::Unretained(this)));
+}
+
+void AdBlockBaseService::OnScheduledRebuildEngine() {
+  // Already covered if an engine was published since it was scheduled
+  if (!rebuild_engine_pending_) {
+    return;
+  }
+  RebuildEngine();
+}
+
+void AdBlockBaseService::PublishEngine(
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  // Every published engine carries the current tags and resources
+  rebuild_engine_pending_ = false;
+  std::for_each(tags_.begin(), tags_.end(),
+                [&](const std::string tag) { ad_block_client->addTag(tag); });
+  ad_block_client->addResources(resources_);
+
+  // The replaced engine is released outside of the lock
+  std::shared_ptr<adblock::Engine> old_ad_block_client;
+  {
+    base::AutoLock lock(ad_block_client_lock_);
+    old_ad_block_client = std::move(ad_block_client_);
+    ad_block_client_ = std::move(ad_block_client);
+  }
+  // Advanced after the swap, so a result tagged with the previous generation
+  // can never outlive the engine it was computed against
+  AdvanceEngineGeneration();
 }
 
 bool AdBlockBaseService::Init() {
@@ -258,12 +383,12 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
-  ad_block_client_.reset(new adblock::Engine(rules));
-  AddKnownTagsToAdBlockInstance();
+  dat_file_path_.clear();
+  rules_ = rules;
   if (!resources.empty()) {
     resources_ = resources;
   }
-  AddKnownResourcesToAdBlockInstance();
+  PublishEngine(CreateEngine());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
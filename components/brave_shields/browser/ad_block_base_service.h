@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -16,8 +17,10 @@
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
@@ -40,17 +43,40 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
 
+  // Safe to call from any thread, see GetEngine().
   bool ShouldStartRequest(const GURL& url,
                           blink::mojom::ResourceType resource_type,
                           const std::string& tab_host,
                           bool* did_match_exception,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url) override;
+  // Matches the request against each of |engines| in order. The first list
+  // with a matching blocking or exception filter decides the request.
+  static bool ShouldStartRequestWithEngines(
+      const std::vector<std::shared_ptr<adblock::Engine>>& engines,
+      const GURL& url,
+      blink::mojom::ResourceType resource_type,
+      const std::string& tab_host,
+      bool* did_match_exception,
+      bool* cancel_request_explicitly,
+      std::string* mock_data_url);
+
+  // Returns the engine currently used for matching. A published engine is
+  // never modified: tag, resource and list changes build a replacement on
+  // the task runner and swap it in, so a snapshot can be queried from any
+  // thread while that happens.
+  std::shared_ptr<adblock::Engine> GetEngine();
+  // Incremented whenever any ad block service publishes a new engine.
+  // Read it before taking engine snapshots to tag results derived from them.
+  static uint64_t GetEngineGeneration();
+  // Called when the set of lists used for matching changes.
+  static void AdvanceEngineGeneration();
+
   void AddResources(const std::string& resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
-  base::Optional<base::Value> UrlCosmeticResources(
+  base::Optional<CosmeticResources> UrlCosmeticResources(
           const std::string& url);
   base::Optional<base::Value> HiddenClassIdSelectors(
           const std::vector<std::string>& classes,
@@ -62,20 +88,38 @@ class AdBlockBaseService : public BaseBraveShieldsService {
   bool Init() override;
 
   void GetDATFileData(const base::FilePath& dat_file_path);
-  void AddKnownTagsToAdBlockInstance();
-  void AddKnownResourcesToAdBlockInstance();
+  // Replaces the engine with one built from filter |rules|.
+  void UpdateRules(const std::string& rules);
   void ResetForTest(const std::string& rules, const std::string& resources);
 
-  std::unique_ptr<adblock::Engine> ad_block_client_;
-
  private:
   void UpdateAdBlockClient(
+      const base::FilePath& dat_file_path,
       std::unique_ptr<adblock::Engine> ad_block_client);
-  void OnGetDATFileData(GetDATFileDataResult result);
+  void OnGetDATFileData(const base::FilePath& dat_file_path,
+                        GetDATFileDataResult result);
   void OnPreferenceChanges(const std::string& pref_name);
 
+  std::unique_ptr<adblock::Engine> CreateEngine();
+  void RebuildEngine();
+  // Tag and resource changes that arrive together, e.g. from several
+  // preferences at startup, share a single rebuild.
+  void ScheduleRebuildEngine();
+  void OnScheduledRebuildEngine();
+  void PublishEngine(std::unique_ptr<adblock::Engine> ad_block_client);
+
   std::vector<std::string> tags_;
   std::string resources_;
+  // Where the current engine was built from, either a DAT file or filter
+  // rules, so it can be rebuilt when tags or resources change.
+  base::FilePath dat_file_path_;
+  std::string rules_;
+  bool rebuild_engine_pending_;
+
+  static std::atomic<uint64_t> engine_generation_;
+
+  base::Lock ad_block_client_lock_;
+  std::shared_ptr<adblock::Engine> ad_block_client_;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
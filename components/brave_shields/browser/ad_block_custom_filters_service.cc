@@ -55,8 +55,7 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
 
 void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
     const std::string& custom_filters) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+  UpdateRules(custom_filters);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,75 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include <utility>
+
+#include "base/strings/string_number_conversions.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::string GetKey(const GURL& url,
+                   const std::string& tab_host,
+                   blink::mojom::ResourceType resource_type) {
+  // Neither a host nor a number can contain a space
+  std::string key = base::NumberToString(static_cast<int>(resource_type));
+  key += ' ';
+  key += tab_host;
+  key += ' ';
+  key += url.spec();
+  return key;
+}
+
+}  // namespace
+
+AdBlockDecisionCache::Decision::Decision() = default;
+
+AdBlockDecisionCache::Decision::Decision(const Decision& other) = default;
+
+AdBlockDecisionCache::Decision::~Decision() = default;
+
+AdBlockDecisionCache::AdBlockDecisionCache() = default;
+
+AdBlockDecisionCache::~AdBlockDecisionCache() = default;
+
+void AdBlockDecisionCache::Put(const GURL& url,
+                               const std::string& tab_host,
+                               blink::mojom::ResourceType resource_type,
+                               uint64_t generation,
+                               const Decision& decision) {
+  Entry entry;
+  entry.generation = generation;
+  entry.decision = decision;
+  cache_.Put(GetKey(url, tab_host, resource_type), std::move(entry));
+}
+
+bool AdBlockDecisionCache::Get(const GURL& url,
+                               const std::string& tab_host,
+                               blink::mojom::ResourceType resource_type,
+                               uint64_t generation,
+                               Decision* decision) {
+  Entry entry;
+  // Entries computed against engines that have since been replaced
+  // are dropped
+  if (!cache_.GetIf(GetKey(url, tab_host, resource_type), &entry,
+                    [generation](const Entry& cached) {
+                      return cached.generation == generation;
+                    })) {
+    return false;
+  }
+
+  *decision = entry.decision;
+  return true;
+}
+
+void AdBlockDecisionCache::Clear() {
+  cache_.Clear();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/sharded_mru_cache.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// Caches ad block outcomes for identical requests, keyed by the request URL,
+// the first-party host and the resource type. Matching runs concurrently on
+// the thread pool, so entries live in a ShardedMRUCache.
+// Every entry records the engine generation it was computed against and is
+// dropped once lists, tags or resources have changed since.
+class AdBlockDecisionCache {
+ public:
+  struct Decision {
+    Decision();
+    Decision(const Decision& other);
+    ~Decision();
+
+    bool should_start_request = true;
+    bool did_match_exception = false;
+    bool cancel_request_explicitly = false;
+    // Set when a redirect filter supplies a replacement resource
+    std::string mock_data_url;
+  };
+
+  AdBlockDecisionCache();
+  ~AdBlockDecisionCache();
+
+  void Put(const GURL& url,
+           const std::string& tab_host,
+           blink::mojom::ResourceType resource_type,
+           uint64_t generation,
+           const Decision& decision);
+  bool Get(const GURL& url,
+           const std::string& tab_host,
+           blink::mojom::ResourceType resource_type,
+           uint64_t generation,
+           Decision* decision);
+  void Clear();
+
+  uint64_t hits() const { return cache_.hits(); }
+  uint64_t misses() const { return cache_.misses(); }
+
+ private:
+  struct Entry {
+    uint64_t generation = 0;
+    Decision decision;
+  };
+
+  ShardedMRUCache<Entry> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
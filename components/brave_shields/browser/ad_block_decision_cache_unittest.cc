@@ -0,0 +1,65 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using blink::mojom::ResourceType;
+
+namespace brave_shields {
+
+TEST(AdBlockDecisionCacheTest, Operations) {
+  AdBlockDecisionCache cache;
+  const GURL url("https://tracker.example/pixel.gif");
+  AdBlockDecisionCache::Decision decision;
+
+  EXPECT_FALSE(cache.Get(url, "news.example", ResourceType::kImage, 1,
+                         &decision));
+
+  AdBlockDecisionCache::Decision blocked;
+  blocked.should_start_request = false;
+  blocked.mock_data_url = "data:image/gif;base64,R0lGODlhAQABAAAAACw=";
+  cache.Put(url, "news.example", ResourceType::kImage, 1, blocked);
+
+  ASSERT_TRUE(cache.Get(url, "news.example", ResourceType::kImage, 1,
+                        &decision));
+  EXPECT_FALSE(decision.should_start_request);
+  EXPECT_EQ(decision.mock_data_url, blocked.mock_data_url);
+
+  // The first-party host and resource type are part of the key
+  EXPECT_FALSE(cache.Get(url, "other.example", ResourceType::kImage, 1,
+                         &decision));
+  EXPECT_FALSE(cache.Get(url, "news.example", ResourceType::kScript, 1,
+                         &decision));
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 3u);
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get(url, "news.example", ResourceType::kImage, 1,
+                         &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, Generation) {
+  AdBlockDecisionCache cache;
+  const GURL url("https://cdn.example/lib.js");
+  AdBlockDecisionCache::Decision decision;
+
+  cache.Put(url, "news.example", ResourceType::kScript, 1,
+            AdBlockDecisionCache::Decision());
+  ASSERT_TRUE(cache.Get(url, "news.example", ResourceType::kScript, 1,
+                        &decision));
+  EXPECT_TRUE(decision.should_start_request);
+
+  // Entries computed before the engines changed are discarded
+  EXPECT_FALSE(cache.Get(url, "news.example", ResourceType::kScript, 2,
+                         &decision));
+  EXPECT_FALSE(cache.Get(url, "news.example", ResourceType::kScript, 1,
+                         &decision));
+}
+
+}  // namespace brave_shields
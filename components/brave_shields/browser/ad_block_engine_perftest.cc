@@ -0,0 +1,150 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/system/sys_info.h"
+#include "base/threading/simple_thread.h"
+#include "base/timer/elapsed_timer.h"
+#include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+// npm run test -- brave_shields_perftests
+
+namespace brave_shields {
+
+namespace {
+
+const char kMetricPrefix[] = "AdBlock.";
+const char kMetricThroughput[] = "throughput";
+const char kMetricTotalTime[] = "total_time";
+
+const int kFilterCount = 20000;
+const int kUrlCount = 1000;
+const int kChecksPerThread = 20000;
+
+std::string BuildRules() {
+  std::string rules;
+  for (int i = 0; i < kFilterCount; i++) {
+    switch (i % 4) {
+      case 0:
+        rules += base::StringPrintf("||ads%d.example^\n", i);
+        break;
+      case 1:
+        rules += base::StringPrintf("/banner/%d/*$image\n", i);
+        break;
+      case 2:
+        rules += base::StringPrintf("||tracker%d.example^$third-party\n", i);
+        break;
+      default:
+        rules += base::StringPrintf("@@||ads%d.example/allowed^\n", i - 3);
+        break;
+    }
+  }
+  return rules;
+}
+
+std::vector<GURL> BuildUrls() {
+  std::vector<GURL> urls;
+  for (int i = 0; i < kUrlCount; i++) {
+    switch (i % 4) {
+      case 0:
+        urls.push_back(GURL(base::StringPrintf(
+            "https://ads%d.example/script.js", (i * 13) % kFilterCount)));
+        break;
+      case 1:
+        urls.push_back(GURL(base::StringPrintf(
+            "https://cdn.example/banner/%d/ad.png", i)));
+        break;
+      case 2:
+        urls.push_back(GURL(base::StringPrintf(
+            "https://tracker%d.example/pixel", i)));
+        break;
+      default:
+        urls.push_back(GURL(base::StringPrintf(
+            "https://content%d.example/article/%d.html", i, i)));
+        break;
+    }
+  }
+  return urls;
+}
+
+// Runs request checks against an engine shared with the other threads, as
+// the network delegate does for concurrent requests
+class MatchDelegate : public base::DelegateSimpleThread::Delegate {
+ public:
+  MatchDelegate(
+      const std::vector<std::shared_ptr<adblock::Engine>>* engines,
+      const std::vector<GURL>* urls)
+      : engines_(engines), urls_(urls) {}
+
+  void Run() override {
+    for (int i = 0; i < kChecksPerThread; i++) {
+      const GURL& url = (*urls_)[i % urls_->size()];
+      bool did_match_exception = false;
+      bool cancel_request_explicitly = false;
+      std::string mock_data_url;
+      AdBlockBaseService::ShouldStartRequestWithEngines(
+          *engines_, url, blink::mojom::ResourceType::kScript, "news.example",
+          &did_match_exception, &cancel_request_explicitly, &mock_data_url);
+    }
+  }
+
+ private:
+  const std::vector<std::shared_ptr<adblock::Engine>>* engines_;
+  const std::vector<GURL>* urls_;
+};
+
+}  // namespace
+
+class AdBlockEnginePerfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    adblock::SetDomainResolver(AdBlockServiceDomainResolver);
+    engines_.push_back(std::make_shared<adblock::Engine>(BuildRules()));
+    urls_ = BuildUrls();
+  }
+
+  std::vector<std::shared_ptr<adblock::Engine>> engines_;
+  std::vector<GURL> urls_;
+};
+
+TEST_F(AdBlockEnginePerfTest, ShouldStartRequestThroughput) {
+  const int max_threads = base::SysInfo::NumberOfProcessors();
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    MatchDelegate delegate(&engines_, &urls_);
+    std::vector<std::unique_ptr<base::DelegateSimpleThread>> pool;
+    for (int i = 0; i < threads; i++) {
+      pool.push_back(std::make_unique<base::DelegateSimpleThread>(
+          &delegate, base::StringPrintf("AdBlockPerf%d", i)));
+    }
+
+    base::ElapsedTimer timer;
+    for (auto& thread : pool) {
+      thread->Start();
+    }
+    for (auto& thread : pool) {
+      thread->Join();
+    }
+    const base::TimeDelta elapsed = timer.Elapsed();
+
+    perf_test::PerfResultReporter reporter(
+        kMetricPrefix, base::StringPrintf("threads_%d", threads));
+    reporter.RegisterImportantMetric(kMetricThroughput, "checks/s");
+    reporter.RegisterImportantMetric(kMetricTotalTime, "ms");
+    reporter.AddResult(kMetricThroughput,
+                       threads * kChecksPerThread / elapsed.InSecondsF());
+    reporter.AddResult(kMetricTotalTime, elapsed.InMillisecondsF());
+  }
+}
+
+}  // namespace brave_shields
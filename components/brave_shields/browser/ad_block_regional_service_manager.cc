@@ -130,19 +130,21 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* matching_exception_filter,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
+  std::vector<std::shared_ptr<adblock::Engine>> engines;
+  GetEngines(&engines);
+  return AdBlockBaseService::ShouldStartRequestWithEngines(
+      engines, url, resource_type, tab_host, matching_exception_filter,
+      cancel_request_explicitly, mock_data_url);
+}
+
+void AdBlockRegionalServiceManager::GetEngines(
+    std::vector<std::shared_ptr<adblock::Engine>>* engines) {
+  // Only snapshots are taken under the lock so concurrent requests don't
+  // serialize on it while matching
   base::AutoLock lock(regional_services_lock_);
   for (const auto& regional_service : regional_services_) {
-    if (!regional_service.second->ShouldStartRequest(
-            url, resource_type, tab_host, matching_exception_filter,
-            cancel_request_explicitly, mock_data_url)) {
-      return false;
-    }
-    if (matching_exception_filter && *matching_exception_filter) {
-      return true;
-    }
+    engines->push_back(regional_service.second->GetEngine());
   }
-
-  return true;
 }
 
 void AdBlockRegionalServiceManager::EnableTag(const std::string& tag,
@@ -183,6 +185,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(
       DCHECK(it != regional_services_.end());
       it->second->Unregister();
       regional_services_.erase(it);
+      AdBlockBaseService::AdvanceEngineGeneration();
     }
   }
 
@@ -194,23 +197,17 @@ void AdBlockRegionalServiceManager::EnableFilterList(
                      base::Unretained(this), uuid, enabled));
 }
 
-base::Optional<base::Value>
+base::Optional<CosmeticResources>
 AdBlockRegionalServiceManager::UrlCosmeticResources(
         const std::string& url) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return base::Optional<base::Value>();
-  }
-  base::Optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
-
-  for ( ; it != regional_services_.end(); it++) {
-    base::Optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
+  base::Optional<CosmeticResources> first_value;
+  for (const auto& regional_service : regional_services_) {
+    base::Optional<CosmeticResources> next_value =
+        regional_service.second->UrlCosmeticResources(url);
     if (first_value) {
       if (next_value) {
-        MergeResourcesInto(std::move(*next_value), &*first_value, false);
+        first_value->MergeFrom(std::move(*next_value), false);
       }
     } else {
       first_value = std::move(next_value);
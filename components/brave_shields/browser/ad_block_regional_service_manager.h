@@ -17,6 +17,7 @@
 #include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "brave/components/brave_component_updater/browser/brave_component.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -53,11 +54,13 @@ class AdBlockRegionalServiceManager {
                           bool* matching_exception_filter,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url);
+  // Appends a snapshot of each enabled regional list's engine to |engines|.
+  void GetEngines(std::vector<std::shared_ptr<adblock::Engine>>* engines);
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
   void EnableFilterList(const std::string& uuid, bool enabled);
 
-  base::Optional<base::Value> UrlCosmeticResources(
+  base::Optional<CosmeticResources> UrlCosmeticResources(
           const std::string& url);
   base::Optional<base::Value> HiddenClassIdSelectors(
           const std::vector<std::string>& classes,
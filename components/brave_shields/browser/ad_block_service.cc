@@ -26,10 +26,10 @@
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 #define DAT_FILE "rs-ABPFilterParserData.dat"
 #define REGIONAL_CATALOG "regional_catalog.json"
+#define COSMETIC_RESOURCES_CACHE_SIZE 100
 
 namespace brave_shields {
 
@@ -48,24 +48,6 @@ std::string GetTagFromPrefName(const std::string& pref_name) {
   return "";
 }
 
-// Extracts the start and end characters of a domain from a hostname.
-// Required for correct functionality of adblock-rust.
-void AdBlockServiceDomainResolver(const char* host, uint32_t* start,
-    uint32_t* end) {
-  const auto host_str = std::string(host);
-  const auto domain = net::registry_controlled_domains::GetDomainAndRegistry(
-      host_str,
-      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
-  const size_t match = host_str.rfind(domain);
-  if (match != std::string::npos) {
-    *start = match;
-    *end = match + domain.length();
-  } else {
-    *start = 0;
-    *end = host_str.length();
-  }
-}
-
 }  // namespace
 
 std::string AdBlockService::g_ad_block_component_id_(kAdBlockComponentId);
@@ -80,6 +62,43 @@ AdBlockRegionalServiceManager* AdBlockService::regional_service_manager() {
   return regional_service_manager_.get();
 }
 
+AdBlockDecisionCache* AdBlockService::decision_cache() {
+  return &decision_cache_;
+}
+
+base::Optional<CosmeticResources> AdBlockService::MergedUrlCosmeticResources(
+    const std::string& url) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // Read before the engines are queried, see GetEngineGeneration()
+  const uint64_t generation = GetEngineGeneration();
+  // Keyed by the full url, generichide exceptions can match any part of it
+  auto it = cosmetic_resources_cache_.Get(url);
+  if (it != cosmetic_resources_cache_.end() &&
+      it->second.generation == generation) {
+    return it->second.resources;
+  }
+
+  base::Optional<CosmeticResources> resources = UrlCosmeticResources(url);
+  if (resources) {
+    base::Optional<CosmeticResources> regional_resources =
+        regional_service_manager()->UrlCosmeticResources(url);
+    if (regional_resources) {
+      resources->MergeFrom(std::move(*regional_resources),
+                           /*force_hide=*/false);
+    }
+
+    base::Optional<CosmeticResources> custom_resources =
+        custom_filters_service()->UrlCosmeticResources(url);
+    if (custom_resources) {
+      resources->MergeFrom(std::move(*custom_resources), /*force_hide=*/true);
+    }
+  }
+
+  cosmetic_resources_cache_.Put(url,
+                                CachedCosmeticResources{generation, resources});
+  return resources;
+}
+
 brave_shields::AdBlockCustomFiltersService*
 AdBlockService::custom_filters_service() {
   if (!custom_filters_service_)
@@ -92,7 +111,8 @@ AdBlockService::custom_filters_service() {
 AdBlockService::AdBlockService(
     brave_component_updater::BraveComponent::Delegate* delegate)
     : AdBlockBaseService(delegate),
-      component_delegate_(delegate) {
+      component_delegate_(delegate),
+      cosmetic_resources_cache_(COSMETIC_RESOURCES_CACHE_SIZE) {
 }
 
 AdBlockService::~AdBlockService() {}
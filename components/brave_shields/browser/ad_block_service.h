@@ -12,7 +12,10 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/optional.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "content/public/browser/browser_thread.h"
@@ -48,6 +51,15 @@ class AdBlockService : public AdBlockBaseService {
 
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockCustomFiltersService* custom_filters_service();
+  // Decisions across the default, regional and custom lists
+  AdBlockDecisionCache* decision_cache();
+
+  // Returns the cosmetic resources for |url| merged across the default,
+  // regional and custom lists. Results are cached per url, because exception
+  // rules such as $generichide can match the whole url, until any of the
+  // lists change.
+  base::Optional<CosmeticResources> MergedUrlCosmeticResources(
+      const std::string& url);
 
  protected:
   bool Init() override;
@@ -72,6 +84,16 @@ class AdBlockService : public AdBlockBaseService {
       custom_filters_service_;
 
   BraveComponent::Delegate* component_delegate_;
+  AdBlockDecisionCache decision_cache_;
+
+  struct CachedCosmeticResources {
+    // See AdBlockBaseService::GetEngineGeneration()
+    uint64_t generation;
+    base::Optional<CosmeticResources> resources;
+  };
+  // Keyed by frame url, only used on the ad block task runner
+  base::MRUCache<std::string, CachedCosmeticResources>
+      cosmetic_resources_cache_;
 
   base::WeakPtrFactory<AdBlockService> weak_factory_{this};
   DISALLOW_COPY_AND_ASSIGN(AdBlockService);
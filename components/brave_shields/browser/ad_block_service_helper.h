@@ -25,7 +25,11 @@ std::vector<adblock::FilterList>::const_iterator FindAdBlockFilterListByLocale(
 std::vector<adblock::FilterList> RegionalCatalogFromJSON(
     const std::string& catalog_json);
 
-void MergeResourcesInto(base::Value from, base::Value* into, bool force_hide);
+// Extracts the start and end characters of a domain from a hostname.
+// Required for correct functionality of adblock-rust.
+void AdBlockServiceDomainResolver(const char* host,
+                                  uint32_t* start,
+                                  uint32_t* end);
 
 }  // namespace brave_shields
 
@@ -159,6 +159,8 @@ void BraveShieldsWebContentsObserver::RenderFrameCreated(
 
 void BraveShieldsWebContentsObserver::RenderFrameDeleted(
     RenderFrameHost* rfh) {
+  class_id_seen_sets_.erase(rfh->GetFrameTreeNodeId());
+
   base::AutoLock lock(frame_data_map_lock_);
   const RenderFrameIdKey key(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
   frame_key_to_tab_url_.erase(key);
@@ -177,6 +179,11 @@ void BraveShieldsWebContentsObserver::RenderFrameHostChanged(
 
 void BraveShieldsWebContentsObserver::DidFinishNavigation(
     content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->HasCommitted() &&
+      !navigation_handle->IsSameDocument()) {
+    class_id_seen_sets_.erase(navigation_handle->GetFrameTreeNodeId());
+  }
+
   RenderFrameHost* main_frame = web_contents()->GetMainFrame();
   if (!web_contents() || !main_frame) {
     return;
@@ -220,6 +227,16 @@ void BraveShieldsWebContentsObserver::AddBlockedSubresource(
   blocked_url_paths_.insert(subresource);
 }
 
+ClassIdSeenSet* BraveShieldsWebContentsObserver::GetClassIdSeenSet(
+    RenderFrameHost* render_frame_host) {
+  std::unique_ptr<ClassIdSeenSet>& seen_set =
+      class_id_seen_sets_[render_frame_host->GetFrameTreeNodeId()];
+  if (!seen_set) {
+    seen_set = std::make_unique<ClassIdSeenSet>();
+  }
+  return seen_set.get();
+}
+
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     std::string block_type,
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "brave/components/brave_shields/browser/class_id_seen_set.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -48,6 +50,10 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Returns the classes, ids and selectors already exchanged with the
+  // document currently loaded in |render_frame_host|.
+  ClassIdSeenSet* GetClassIdSeenSet(
+      content::RenderFrameHost* render_frame_host);
 
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
@@ -98,6 +104,9 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
+  // Keyed by frame tree node id, dropped when the frame commits a new
+  // document.
+  std::map<int, std::unique_ptr<ClassIdSeenSet>> class_id_seen_sets_;
 
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
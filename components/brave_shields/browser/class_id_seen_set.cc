@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/class_id_seen_set.h"
+
+#include <algorithm>
+
+namespace brave_shields {
+
+namespace {
+
+void TakeUnseenValues(std::vector<std::string>* values,
+                      std::unordered_set<std::string>* seen) {
+  values->erase(std::remove_if(values->begin(), values->end(),
+                               [seen](const std::string& value) {
+                                 return !seen->insert(value).second;
+                               }),
+                values->end());
+}
+
+}  // namespace
+
+ClassIdSeenSet::ClassIdSeenSet() = default;
+
+ClassIdSeenSet::~ClassIdSeenSet() = default;
+
+bool ClassIdSeenSet::TakeUnseen(std::vector<std::string>* classes,
+                                std::vector<std::string>* ids) {
+  TakeUnseenValues(classes, &classes_);
+  TakeUnseenValues(ids, &ids_);
+  return !classes->empty() || !ids->empty();
+}
+
+bool ClassIdSeenSet::AddSelector(const std::string& selector,
+                                 bool force_hide) {
+  if (force_hide) {
+    return force_hide_selectors_.insert(selector).second;
+  }
+  return selectors_.insert(selector).second;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,45 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_CLASS_ID_SEEN_SET_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_CLASS_ID_SEEN_SET_H_
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+
+namespace brave_shields {
+
+// Remembers, for a single document, which classes and ids hidden selectors
+// were already looked up for and which selectors were already returned, so
+// mutation-heavy pages only pay for the values they have not sent before.
+class ClassIdSeenSet : public base::SupportsWeakPtr<ClassIdSeenSet> {
+ public:
+  ClassIdSeenSet();
+  ~ClassIdSeenSet();
+
+  // Removes classes and ids that were already seen, including duplicates
+  // within the same call, and records the rest. Returns false when nothing
+  // is left to look up.
+  bool TakeUnseen(std::vector<std::string>* classes,
+                  std::vector<std::string>* ids);
+  // Returns true the first time |selector| is returned to the document.
+  bool AddSelector(const std::string& selector, bool force_hide);
+
+ private:
+  std::unordered_set<std::string> classes_;
+  std::unordered_set<std::string> ids_;
+  std::unordered_set<std::string> selectors_;
+  std::unordered_set<std::string> force_hide_selectors_;
+
+  DISALLOW_COPY_AND_ASSIGN(ClassIdSeenSet);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_CLASS_ID_SEEN_SET_H_
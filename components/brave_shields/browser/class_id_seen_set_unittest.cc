@@ -0,0 +1,47 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_shields/browser/class_id_seen_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(ClassIdSeenSetTest, TakeUnseen) {
+  ClassIdSeenSet seen;
+
+  std::vector<std::string> classes = {"a", "b", "a"};
+  std::vector<std::string> ids = {"c"};
+  EXPECT_TRUE(seen.TakeUnseen(&classes, &ids));
+  EXPECT_EQ(classes, std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(ids, std::vector<std::string>({"c"}));
+
+  // Classes and ids are tracked separately
+  classes = {"b", "c"};
+  ids = {"c", "a"};
+  EXPECT_TRUE(seen.TakeUnseen(&classes, &ids));
+  EXPECT_EQ(classes, std::vector<std::string>({"c"}));
+  EXPECT_EQ(ids, std::vector<std::string>({"a"}));
+
+  classes = {"a", "c"};
+  ids = {"a"};
+  EXPECT_FALSE(seen.TakeUnseen(&classes, &ids));
+  EXPECT_TRUE(classes.empty());
+  EXPECT_TRUE(ids.empty());
+}
+
+TEST(ClassIdSeenSetTest, AddSelector) {
+  ClassIdSeenSet seen;
+
+  EXPECT_TRUE(seen.AddSelector(".ad", false));
+  EXPECT_FALSE(seen.AddSelector(".ad", false));
+  // A selector returned for hiding may still need to be force hidden
+  EXPECT_TRUE(seen.AddSelector(".ad", true));
+  EXPECT_FALSE(seen.AddSelector(".ad", true));
+}
+
+}  // namespace brave_shields
@@ -4,7 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/json/json_reader.h"
-#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -24,17 +24,23 @@ class CosmeticResourceMergeTest : public testing::Test {
           const std::string& expected) {
     base::Optional<base::Value> a_val = base::JSONReader::Read(a);
     ASSERT_TRUE(a_val);
+    base::Optional<CosmeticResources> a_resources =
+        CosmeticResources::FromValue(*a_val);
+    ASSERT_TRUE(a_resources);
 
     base::Optional<base::Value> b_val = base::JSONReader::Read(b);
     ASSERT_TRUE(b_val);
+    base::Optional<CosmeticResources> b_resources =
+        CosmeticResources::FromValue(*b_val);
+    ASSERT_TRUE(b_resources);
 
     const base::Optional<base::Value> expected_val =
         base::JSONReader::Read(expected);
     ASSERT_TRUE(expected_val);
 
-    MergeResourcesInto(std::move(b_val.value()), &*a_val, force_hide);
+    a_resources->MergeFrom(std::move(*b_resources), force_hide);
 
-    ASSERT_EQ(*a_val, *expected_val);
+    ASSERT_EQ(a_resources->ToValue(), *expected_val);
   }
 
  protected:
@@ -73,7 +79,8 @@ TEST_F(CosmeticResourceMergeTest, MergeTwoEmptyResources) {
       "\"style_selectors\": {}, "
       "\"exceptions\": [], "
       "\"injected_script\": \"\n\", "
-      "\"generichide\": false"
+      "\"generichide\": false, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -93,7 +100,8 @@ TEST_F(CosmeticResourceMergeTest, MergeEmptyIntoNonEmpty) {
       "}, "
       "\"exceptions\": [\"e\", \"f\"], "
       "\"injected_script\": \"console.log('g')\n\", "
-      "\"generichide\": false"
+      "\"generichide\": false, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -113,7 +121,8 @@ TEST_F(CosmeticResourceMergeTest, MergeNonEmptyIntoEmpty) {
       "}, "
       "\"exceptions\": [\"e\", \"f\"], "
       "\"injected_script\": \"\nconsole.log('g')\", "
-      "\"generichide\": false"
+      "\"generichide\": false, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -142,7 +151,8 @@ TEST_F(CosmeticResourceMergeTest, MergeNonEmptyIntoNonEmpty) {
       "}, "
       "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
       "\"injected_script\": \"console.log('g')\nconsole.log('n')\", "
-      "\"generichide\": false"
+      "\"generichide\": false, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -211,7 +221,8 @@ TEST_F(CosmeticResourceMergeTest, MergeNonGenerichideIntoGenerichide) {
       "\"style_selectors\": {}, "
       "\"exceptions\": [], "
       "\"injected_script\": \"\n\n\", "
-      "\"generichide\": true"
+      "\"generichide\": true, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -240,7 +251,8 @@ TEST_F(CosmeticResourceMergeTest, MergeGenerichideIntoNonGenerichide) {
       "}, "
       "\"exceptions\": [\"e\", \"f\", \"l\", \"m\"], "
       "\"injected_script\": \"console.log('g')\nconsole.log('n')\", "
-      "\"generichide\": true"
+      "\"generichide\": true, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -260,7 +272,8 @@ TEST_F(CosmeticResourceMergeTest, MergeGenerichideIntoGenerichide) {
       "\"style_selectors\": {}, "
       "\"exceptions\": [], "
       "\"injected_script\": \"\n\", "
-      "\"generichide\": true"
+      "\"generichide\": true, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, a, false, expected);
@@ -300,7 +313,8 @@ TEST_F(CosmeticResourceMergeTest, MergeStyles) {
       "}, "
       "\"exceptions\": [], "
       "\"injected_script\": \"\n\", "
-      "\"generichide\": false"
+      "\"generichide\": false, "
+      "\"force_hide_selectors\": []"
   "}";
 
   CompareMergeFromStrings(a, b, false, expected);
@@ -0,0 +1,121 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
+
+#include <iterator>
+#include <utility>
+
+namespace brave_shields {
+
+namespace {
+
+std::vector<std::string> StringsFromList(const base::Value* list) {
+  std::vector<std::string> strings;
+  if (!list || !list->is_list()) {
+    return strings;
+  }
+  strings.reserve(list->GetList().size());
+  for (const auto& item : list->GetList()) {
+    if (item.is_string()) {
+      strings.push_back(item.GetString());
+    }
+  }
+  return strings;
+}
+
+base::Value ListFromStrings(const std::vector<std::string>& strings) {
+  base::Value list(base::Value::Type::LIST);
+  for (const auto& string : strings) {
+    list.Append(string);
+  }
+  return list;
+}
+
+void AppendStrings(std::vector<std::string> from,
+                   std::vector<std::string>* into) {
+  if (into->empty()) {
+    *into = std::move(from);
+    return;
+  }
+  into->insert(into->end(), std::make_move_iterator(from.begin()),
+               std::make_move_iterator(from.end()));
+}
+
+}  // namespace
+
+CosmeticResources::CosmeticResources() = default;
+
+CosmeticResources::CosmeticResources(const CosmeticResources& other) = default;
+
+CosmeticResources::CosmeticResources(CosmeticResources&& other) = default;
+
+CosmeticResources& CosmeticResources::operator=(
+    const CosmeticResources& other) = default;
+
+CosmeticResources& CosmeticResources::operator=(CosmeticResources&& other) =
+    default;
+
+CosmeticResources::~CosmeticResources() = default;
+
+// static
+base::Optional<CosmeticResources> CosmeticResources::FromValue(
+    const base::Value& value) {
+  if (!value.is_dict()) {
+    return base::nullopt;
+  }
+
+  CosmeticResources resources;
+  resources.hide_selectors = StringsFromList(value.FindKey("hide_selectors"));
+  resources.force_hide_selectors =
+      StringsFromList(value.FindKey("force_hide_selectors"));
+  const base::Value* style_selectors = value.FindDictKey("style_selectors");
+  if (style_selectors) {
+    for (const auto& item : style_selectors->DictItems()) {
+      resources.style_selectors[item.first] = StringsFromList(&item.second);
+    }
+  }
+  resources.exceptions = StringsFromList(value.FindKey("exceptions"));
+  const std::string* injected_script = value.FindStringKey("injected_script");
+  if (injected_script) {
+    resources.injected_script = *injected_script;
+  }
+  resources.generichide = value.FindBoolKey("generichide").value_or(false);
+  return resources;
+}
+
+base::Value CosmeticResources::ToValue() const {
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("hide_selectors", ListFromStrings(hide_selectors));
+  value.SetKey("force_hide_selectors", ListFromStrings(force_hide_selectors));
+  base::Value style_selectors_value(base::Value::Type::DICTIONARY);
+  for (const auto& item : style_selectors) {
+    style_selectors_value.SetKey(item.first, ListFromStrings(item.second));
+  }
+  value.SetKey("style_selectors", std::move(style_selectors_value));
+  value.SetKey("exceptions", ListFromStrings(exceptions));
+  value.SetStringKey("injected_script", injected_script);
+  value.SetBoolKey("generichide", generichide);
+  return value;
+}
+
+void CosmeticResources::MergeFrom(CosmeticResources from, bool force_hide) {
+  AppendStrings(std::move(from.hide_selectors),
+                force_hide ? &force_hide_selectors : &hide_selectors);
+  AppendStrings(std::move(from.force_hide_selectors), &force_hide_selectors);
+
+  for (auto& item : from.style_selectors) {
+    AppendStrings(std::move(item.second), &style_selectors[item.first]);
+  }
+
+  AppendStrings(std::move(from.exceptions), &exceptions);
+
+  injected_script += '\n';
+  injected_script += from.injected_script;
+
+  generichide = generichide || from.generichide;
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,49 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/optional.h"
+#include "base/values.h"
+
+namespace brave_shields {
+
+// The url-specific cosmetic filtering resources of a page, as returned by
+// adblock-rust's urlCosmeticResources.
+struct CosmeticResources {
+  CosmeticResources();
+  CosmeticResources(const CosmeticResources& other);
+  CosmeticResources(CosmeticResources&& other);
+  CosmeticResources& operator=(const CosmeticResources& other);
+  CosmeticResources& operator=(CosmeticResources&& other);
+  ~CosmeticResources();
+
+  // Reads the engine's output, returns nullopt if it isn't a dictionary.
+  static base::Optional<CosmeticResources> FromValue(const base::Value& value);
+  // The representation expected by the cosmetic filtering content scripts.
+  base::Value ToValue() const;
+
+  // Merges the contents of |from| into these resources.
+  //
+  // If |force_hide| is true, the hide selectors of |from| are added to
+  // |force_hide_selectors| rather than |hide_selectors|.
+  void MergeFrom(CosmeticResources from, bool force_hide);
+
+  std::vector<std::string> hide_selectors;
+  std::vector<std::string> force_hide_selectors;
+  std::map<std::string, std::vector<std::string>> style_selectors;
+  std::vector<std::string> exceptions;
+  std::string injected_script;
+  bool generichide = false;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_H_
@@ -0,0 +1,129 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_index.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+#include "base/sys_byteorder.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kMagic[] = "HTTPSEIX";
+const size_t kMagicSize = sizeof(kMagic) - 1;
+const uint32_t kVersion = 1;
+const size_t kHeaderSize = kMagicSize + 2 * sizeof(uint32_t);
+const size_t kEntrySize = 4 * sizeof(uint32_t);
+
+uint32_t ReadUInt32(const uint8_t* data, size_t offset) {
+  uint32_t value;
+  memcpy(&value, data + offset, sizeof(value));
+  return base::ByteSwapToLE32(value);
+}
+
+}  // namespace
+
+HTTPSEIndex::HTTPSEIndex(std::unique_ptr<base::MemoryMappedFile> file)
+    : file_(std::move(file)),
+      count_(0) {
+}
+
+HTTPSEIndex::~HTTPSEIndex() = default;
+
+// static
+std::unique_ptr<HTTPSEIndex> HTTPSEIndex::Open(const base::FilePath& path) {
+  auto file = std::make_unique<base::MemoryMappedFile>();
+  if (!file->Initialize(path)) {
+    return nullptr;
+  }
+
+  auto index = base::WrapUnique(new HTTPSEIndex(std::move(file)));
+  if (!index->Validate()) {
+    return nullptr;
+  }
+  return index;
+}
+
+bool HTTPSEIndex::Validate() {
+  const uint8_t* data = file_->data();
+  const size_t length = file_->length();
+  if (length < kHeaderSize || memcmp(data, kMagic, kMagicSize) != 0) {
+    LOG(ERROR) << "HTTPSE index has an invalid header";
+    return false;
+  }
+
+  if (ReadUInt32(data, kMagicSize) != kVersion) {
+    LOG(ERROR) << "HTTPSE index has an unsupported version";
+    return false;
+  }
+
+  const size_t count = ReadUInt32(data, kMagicSize + sizeof(uint32_t));
+  if (count > (length - kHeaderSize) / kEntrySize) {
+    LOG(ERROR) << "HTTPSE index is truncated";
+    return false;
+  }
+
+  // Check every key and value once so lookups can skip bounds checks
+  for (size_t i = 0; i < count; i++) {
+    const size_t entry = kHeaderSize + i * kEntrySize;
+    for (size_t field = 0; field < 4; field += 2) {
+      const uint64_t offset =
+          ReadUInt32(data, entry + field * sizeof(uint32_t));
+      const uint64_t size =
+          ReadUInt32(data, entry + (field + 1) * sizeof(uint32_t));
+      if (offset + size > length) {
+        LOG(ERROR) << "HTTPSE index entry is out of bounds";
+        return false;
+      }
+    }
+  }
+
+  count_ = count;
+  return true;
+}
+
+base::StringPiece HTTPSEIndex::GetPiece(size_t offset) const {
+  const uint8_t* data = file_->data();
+  return base::StringPiece(
+      reinterpret_cast<const char*>(data) + ReadUInt32(data, offset),
+      ReadUInt32(data, offset + sizeof(uint32_t)));
+}
+
+base::StringPiece HTTPSEIndex::GetKey(size_t index) const {
+  return GetPiece(kHeaderSize + index * kEntrySize);
+}
+
+base::StringPiece HTTPSEIndex::GetValue(size_t index) const {
+  return GetPiece(kHeaderSize + index * kEntrySize + 2 * sizeof(uint32_t));
+}
+
+base::StringPiece HTTPSEIndex::Find(base::StringPiece key) const {
+  size_t low = 0;
+  size_t high = count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const int compare = GetKey(middle).compare(key);
+    if (compare == 0) {
+      return GetValue(middle);
+    }
+
+    if (compare < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return base::StringPiece();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,63 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace brave_shields {
+
+// Read-only view over the HTTPS Everywhere rules index shipped with the
+// component, memory mapped so it is queried in place without unpacking.
+// The file is produced by script/generate_httpse_index.py and laid out as
+// (all integers little endian uint32):
+//
+//   header   "HTTPSEIX", version, entry count
+//   entries  key offset, key length, value offset, value length
+//   data     key and value bytes
+//
+// Entries are sorted by key bytes, offsets are from the start of the file.
+class HTTPSEIndex {
+ public:
+  ~HTTPSEIndex();
+
+  // Returns nullptr when the file is missing or malformed.
+  static std::unique_ptr<HTTPSEIndex> Open(const base::FilePath& path);
+
+  // Returns the ruleset stored for |key| or an empty piece. The result
+  // points into the mapping and is valid for the lifetime of the index.
+  base::StringPiece Find(base::StringPiece key) const;
+
+  size_t size() const { return count_; }
+
+ private:
+  explicit HTTPSEIndex(std::unique_ptr<base::MemoryMappedFile> file);
+
+  bool Validate();
+  base::StringPiece GetKey(size_t index) const;
+  base::StringPiece GetValue(size_t index) const;
+  base::StringPiece GetPiece(size_t offset) const;
+
+  std::unique_ptr<base::MemoryMappedFile> file_;
+  size_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSEIndex);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_INDEX_H_
@@ -0,0 +1,105 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "brave/components/brave_shields/browser/https_everywhere_index.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+void AppendUInt32(std::string* out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+// Same layout as script/generate_httpse_index.py
+std::string BuildIndex(const std::map<std::string, std::string>& entries) {
+  std::string header = "HTTPSEIX";
+  AppendUInt32(&header, 1);
+  AppendUInt32(&header, entries.size());
+
+  std::string table;
+  std::string data;
+  uint32_t offset = header.size() + 16 * entries.size();
+  for (const auto& entry : entries) {
+    AppendUInt32(&table, offset + data.size());
+    AppendUInt32(&table, entry.first.size());
+    data += entry.first;
+    AppendUInt32(&table, offset + data.size());
+    AppendUInt32(&table, entry.second.size());
+    data += entry.second;
+  }
+
+  return header + table + data;
+}
+
+}  // namespace
+
+class HTTPSEverywhereIndexTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  std::unique_ptr<HTTPSEIndex> OpenIndex(const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII("httpse.index");
+    EXPECT_EQ(base::WriteFile(path, contents.data(), contents.size()),
+              static_cast<int>(contents.size()));
+    return HTTPSEIndex::Open(path);
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(HTTPSEverywhereIndexTest, Find) {
+  auto index = OpenIndex(BuildIndex({
+      {"com.example", "[1]"},
+      {"com.example.*", "[2]"},
+      {"org.example.www", "[3]"},
+  }));
+  ASSERT_TRUE(index);
+  EXPECT_EQ(index->size(), 3u);
+  EXPECT_EQ(index->Find("com.example"), "[1]");
+  EXPECT_EQ(index->Find("com.example.*"), "[2]");
+  EXPECT_EQ(index->Find("org.example.www"), "[3]");
+  EXPECT_TRUE(index->Find("com.exampl").empty());
+  EXPECT_TRUE(index->Find("net.example").empty());
+  EXPECT_TRUE(index->Find("").empty());
+}
+
+TEST_F(HTTPSEverywhereIndexTest, Empty) {
+  auto index = OpenIndex(BuildIndex({}));
+  ASSERT_TRUE(index);
+  EXPECT_TRUE(index->Find("com.example").empty());
+}
+
+TEST_F(HTTPSEverywhereIndexTest, RejectsMalformedFiles) {
+  EXPECT_FALSE(HTTPSEIndex::Open(temp_dir_.GetPath().AppendASCII("none")));
+  EXPECT_FALSE(OpenIndex("HTTPSE"));
+
+  std::string index = BuildIndex({{"com.example", "[1]"}});
+  std::string bad_magic = index;
+  bad_magic[0] = 'X';
+  EXPECT_FALSE(OpenIndex(bad_magic));
+
+  std::string bad_version = index;
+  bad_version[8] = 2;
+  EXPECT_FALSE(OpenIndex(bad_version));
+
+  EXPECT_FALSE(OpenIndex(index.substr(0, index.size() - 1)));
+  EXPECT_FALSE(OpenIndex(index.substr(0, 20)));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,159 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Rules use $1 style back references, RE2 expects \1
+std::string CorrectToRuleForRE2(const std::string& to) {
+  std::string corrected_to(to);
+  std::replace(corrected_to.begin(), corrected_to.end(), '$', '\\');
+  return corrected_to;
+}
+
+std::unique_ptr<re2::RE2> CompilePattern(const std::string& pattern) {
+  auto regex = std::make_unique<re2::RE2>(pattern, re2::RE2::Quiet);
+  if (!regex->ok()) {
+    return nullptr;
+  }
+  return regex;
+}
+
+}  // namespace
+
+HTTPSERules::Rule::Rule() = default;
+
+HTTPSERules::Rule::Rule(Rule&& other) = default;
+
+HTTPSERules::Rule::~Rule() = default;
+
+HTTPSERules::RuleSet::RuleSet() = default;
+
+HTTPSERules::RuleSet::RuleSet(RuleSet&& other) = default;
+
+HTTPSERules::RuleSet::~RuleSet() = default;
+
+HTTPSERules::HTTPSERules() = default;
+
+HTTPSERules::~HTTPSERules() = default;
+
+// static
+std::unique_ptr<HTTPSERules> HTTPSERules::Create(base::StringPiece json) {
+  auto rules = base::WrapUnique(new HTTPSERules());
+
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list()) {
+    return rules;
+  }
+
+  for (const auto& ruleset_value : json_object->GetList()) {
+    if (!ruleset_value.is_dict()) {
+      continue;
+    }
+
+    RuleSet ruleset;
+    const base::Value* exclusions = ruleset_value.FindListKey("e");
+    if (exclusions) {
+      for (const auto& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict()) {
+          continue;
+        }
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern) {
+          continue;
+        }
+        auto regex = CompilePattern(CorrectToRuleForRE2(*pattern));
+        if (regex) {
+          ruleset.exclusions.push_back(std::move(regex));
+        }
+      }
+    }
+
+    const base::Value* rule_values = ruleset_value.FindListKey("r");
+    ruleset.has_rules = rule_values != nullptr;
+    if (rule_values) {
+      for (const auto& rule_value : rule_values->GetList()) {
+        if (!rule_value.is_dict()) {
+          continue;
+        }
+
+        Rule rule;
+        if (rule_value.FindKey("d")) {
+          rule.is_default = true;
+          ruleset.rules.push_back(std::move(rule));
+          continue;
+        }
+
+        const std::string* from = rule_value.FindStringKey("f");
+        const std::string* to = rule_value.FindStringKey("t");
+        if (!from || !to) {
+          continue;
+        }
+        rule.from = CompilePattern(*from);
+        if (!rule.from) {
+          continue;
+        }
+        rule.to = CorrectToRuleForRE2(*to);
+        ruleset.rules.push_back(std::move(rule));
+      }
+    }
+
+    rules->rulesets_.push_back(std::move(ruleset));
+  }
+
+  return rules;
+}
+
+std::string HTTPSERules::Apply(const std::string& url) const {
+  for (const auto& ruleset : rulesets_) {
+    for (const auto& exclusion : ruleset.exclusions) {
+      if (re2::RE2::FullMatch(url, *exclusion)) {
+        return "";
+      }
+    }
+
+    if (!ruleset.has_rules) {
+      return "";
+    }
+
+    for (const auto& rule : ruleset.rules) {
+      if (rule.is_default) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) &&
+          new_url != url) {
+        return new_url;
+      }
+    }
+  }
+
+  return "";
+}
+
+bool HTTPSERules::UpgradesAllURLs() const {
+  if (rulesets_.empty()) {
+    return false;
+  }
+
+  const RuleSet& ruleset = rulesets_.front();
+  return ruleset.exclusions.empty() && ruleset.has_rules &&
+         !ruleset.rules.empty() && ruleset.rules.front().is_default;
+}
+
+}  // namespace brave_shields
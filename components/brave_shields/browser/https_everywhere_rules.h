@@ -0,0 +1,71 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+
+namespace re2 {
+class RE2;
+}  // namespace re2
+
+namespace brave_shields {
+
+// The rulesets stored for one HTTPS Everywhere lookup domain, with every
+// exclusion and rewrite pattern compiled up front so that applying them to
+// a URL does not parse JSON or build regular expressions.
+class HTTPSERules {
+ public:
+  ~HTTPSERules();
+
+  // Compiles the JSON value stored in the HTTPS Everywhere database. Values
+  // that are not a list of rulesets produce rules that never match.
+  static std::unique_ptr<HTTPSERules> Create(base::StringPiece json);
+
+  // Returns the upgraded URL, or an empty string when no rule applies.
+  std::string Apply(const std::string& url) const;
+
+  // True when Apply() upgrades every http URL by only switching the scheme.
+  bool UpgradesAllURLs() const;
+
+ private:
+  struct Rule {
+    Rule();
+    Rule(Rule&& other);
+    ~Rule();
+
+    // Default rules only switch the scheme to https
+    bool is_default = false;
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  struct RuleSet {
+    RuleSet();
+    RuleSet(RuleSet&& other);
+    ~RuleSet();
+
+    std::vector<std::unique_ptr<re2::RE2>> exclusions;
+    // A ruleset without a rule list ends the lookup
+    bool has_rules = false;
+    std::vector<Rule> rules;
+  };
+
+  HTTPSERules();
+
+  std::vector<RuleSet> rulesets_;
+
+  DISALLOW_COPY_AND_ASSIGN(HTTPSERules);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULES_H_
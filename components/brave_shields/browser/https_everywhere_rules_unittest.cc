@@ -0,0 +1,61 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(HTTPSEverywhereRulesTest, DefaultRule) {
+  auto rules = HTTPSERules::Create(R"([{"r":[{"d":1}]}])");
+  EXPECT_EQ(rules->Apply("http://example.com/"), "https://example.com/");
+}
+
+TEST(HTTPSEverywhereRulesTest, RewriteRule) {
+  auto rules = HTTPSERules::Create(
+      R"([{"r":[{"f":"^http://(www\\.)?example\\.com/",)"
+      R"("t":"https://$1example.com/"}]}])");
+  EXPECT_EQ(rules->Apply("http://www.example.com/path"),
+            "https://www.example.com/path");
+  EXPECT_EQ(rules->Apply("http://example.com/"), "https://example.com/");
+  EXPECT_EQ(rules->Apply("http://other.com/"), "");
+}
+
+TEST(HTTPSEverywhereRulesTest, Exclusion) {
+  auto rules = HTTPSERules::Create(
+      R"([{"e":[{"p":"^http://example\\.com/plain"}],"r":[{"d":1}]}])");
+  EXPECT_EQ(rules->Apply("http://example.com/plain"), "");
+  EXPECT_EQ(rules->Apply("http://example.com/secure"),
+            "https://example.com/secure");
+}
+
+TEST(HTTPSEverywhereRulesTest, MissingRulesEndLookup) {
+  auto rules = HTTPSERules::Create(R"([{"e":[]},{"r":[{"d":1}]}])");
+  EXPECT_EQ(rules->Apply("http://example.com/"), "");
+}
+
+TEST(HTTPSEverywhereRulesTest, UpgradesAllURLs) {
+  EXPECT_TRUE(HTTPSERules::Create(R"([{"r":[{"d":1}]}])")->UpgradesAllURLs());
+  EXPECT_FALSE(HTTPSERules::Create(
+      R"([{"e":[{"p":"^http://example\\.com/plain"}],"r":[{"d":1}]}])")
+          ->UpgradesAllURLs());
+  EXPECT_FALSE(HTTPSERules::Create(
+      R"([{"r":[{"f":"^http://a\\.com/","t":"https://a.com/"},{"d":1}]}])")
+          ->UpgradesAllURLs());
+  EXPECT_FALSE(HTTPSERules::Create("[]")->UpgradesAllURLs());
+}
+
+TEST(HTTPSEverywhereRulesTest, InvalidInput) {
+  EXPECT_EQ(HTTPSERules::Create("not json")->Apply("http://example.com/"), "");
+  EXPECT_EQ(HTTPSERules::Create(R"({"r":[]})")->Apply("http://example.com/"),
+            "");
+  auto rules = HTTPSERules::Create(
+      R"([{"r":[{"f":"(","t":"https://"},{"d":1}]}])");
+  EXPECT_EQ(rules->Apply("http://example.com/"), "https://example.com/");
+}
+
+}  // namespace brave_shields
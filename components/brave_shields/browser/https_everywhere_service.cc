@@ -12,21 +12,20 @@
 
 #include "base/base_paths.h"
 #include "base/bind.h"
-#include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
-#define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
+#define INDEX_FILE "httpse.index"
+#define INDEX_FILE_VERSION "7.0"
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
+#define HTTPSE_RULES_CACHE_SIZE             1000
 
 namespace {
 
@@ -100,12 +99,14 @@ HTTPSEverywhereService::g_https_everywhere_component_base64_public_key_(
 HTTPSEverywhereService::HTTPSEverywhereService(
     BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
-      level_db_(nullptr) {
+      level_db_(nullptr),
+      rules_cache_(HTTPSE_RULES_CACHE_SIZE) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
   GetTaskRunner()->DeleteSoon(FROM_HERE, level_db_);
+  GetTaskRunner()->DeleteSoon(FROM_HERE, index_.release());
 }
 
 bool HTTPSEverywhereService::Init() {
@@ -115,8 +116,26 @@ bool HTTPSEverywhereService::Init() {
   return true;
 }
 
+bool HTTPSEverywhereService::InitIndex(const base::FilePath& install_dir) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  base::FilePath index_file_path =
+      install_dir.AppendASCII(INDEX_FILE_VERSION).AppendASCII(INDEX_FILE);
+  std::unique_ptr<HTTPSEIndex> index = HTTPSEIndex::Open(index_file_path);
+  if (!index) {
+    return false;
+  }
+
+  CloseDatabase();
+  index_ = std::move(index);
+  return true;
+}
+
 void HTTPSEverywhereService::InitDB(const base::FilePath& install_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (InitIndex(install_dir)) {
+    return;
+  }
+
   base::FilePath zip_db_file_path =
       install_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
   base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
@@ -154,54 +173,63 @@ void HTTPSEverywhereService::OnComponentReady(
                  install_dir));
 }
 
+// static
+bool HTTPSEverywhereService::ShouldHTTPSERedirect(int redirects_count) {
+  return redirects_count < HTTPSE_URL_MAX_REDIRECTS_COUNT - 1;
+}
+
+// static
+GURL HTTPSEverywhereService::GetCandidateURL(const GURL& url) {
+  if (g_ignore_port_for_test_ && url.has_port()) {
+    GURL::Replacements replacements;
+    replacements.ClearPort();
+    return url.ReplaceComponents(replacements);
+  }
+  return url;
+}
+
 bool HTTPSEverywhereService::GetHTTPSURL(
     const GURL* url,
-    const uint64_t& request_identifier,
     std::string* new_url) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   if (!url->is_valid())
     return false;
 
-  if (!IsInitialized() || !level_db_ || url->scheme() == url::kHttpsScheme) {
-    return false;
-  }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
+  if (!IsInitialized() || (!index_ && !level_db_) ||
+      url->scheme() == url::kHttpsScheme) {
     return false;
   }
 
-  if (recently_used_cache_.get(url->spec(), new_url)) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    return true;
-  }
-
-  GURL candidate_url(*url);
-  if (g_ignore_port_for_test_ && candidate_url.has_port()) {
-    GURL::Replacements replacements;
-    replacements.ClearPort();
-    candidate_url = candidate_url.ReplaceComponents(replacements);
-  }
-
+  GURL candidate_url = GetCandidateURL(*url);
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        recently_used_cache_.add(candidate_url.spec(), *new_url);
-        AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
+  bool cacheable = true;
+  for (const auto& domain : domains) {
+    const HTTPSERules* rules = GetRules(domain);
+    if (!rules) {
+      continue;
+    }
+
+    *new_url = rules->Apply(candidate_url.spec());
+    if (0 != new_url->length()) {
+      if (cacheable && rules->UpgradesAllURLs()) {
+        host_cache_.Put(candidate_url.host(), HostResult::kUpgrade);
       }
+      return true;
     }
+    // Another URL on the same host may still match these rules
+    cacheable = false;
+  }
+
+  if (cacheable) {
+    host_cache_.Put(candidate_url.host(), HostResult::kNoRules);
   }
-  recently_used_cache_.remove(candidate_url.spec());
   return false;
 }
 
 bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     const GURL* url,
-    const uint64_t& request_identifier,
     std::string* cached_url) {
   if (!url->is_valid())
     return false;
@@ -209,173 +237,50 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
   if (!IsInitialized() || url->scheme() == url::kHttpsScheme) {
     return false;
   }
-  if (!ShouldHTTPSERedirect(request_identifier)) {
-    return false;
-  }
 
-  if (recently_used_cache_.get(url->spec(), cached_url)) {
-    AddHTTPSEUrlToRedirectList(request_identifier);
-    return true;
+  GURL candidate_url = GetCandidateURL(*url);
+  HostResult result;
+  if (!host_cache_.Get(candidate_url.host(), &result)) {
+    return false;
   }
-  return false;
-}
 
-bool HTTPSEverywhereService::ShouldHTTPSERedirect(
-    const uint64_t& request_identifier) {
-  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_ &&
-        httpse_urls_redirects_count_[i].redirects_ >=
-        HTTPSE_URL_MAX_REDIRECTS_COUNT - 1) {
-      return false;
-    }
+  cached_url->clear();
+  if (result == HostResult::kUpgrade) {
+    *cached_url = candidate_url.spec();
+    cached_url->insert(4, "s");
   }
-
   return true;
 }
 
-void HTTPSEverywhereService::AddHTTPSEUrlToRedirectList(
-    const uint64_t& request_identifier) {
-  // Adding redirects count for the current request
-  base::AutoLock auto_lock(httpse_get_urls_redirects_count_mutex_);
-  bool hostFound = false;
-  for (size_t i = 0; i < httpse_urls_redirects_count_.size(); i++) {
-    if (request_identifier ==
-        httpse_urls_redirects_count_[i].request_identifier_) {
-      // Found the host, just increment the redirects_count
-      httpse_urls_redirects_count_[i].redirects_++;
-      hostFound = true;
-      break;
-    }
-  }
-  if (!hostFound) {
-      // The host is new, adding it to the redirects list
-      if (httpse_urls_redirects_count_.size() >=
-          HTTPSE_URLS_REDIRECTS_COUNT_QUEUE) {
-          // The queue is full, erase the first element
-          httpse_urls_redirects_count_.erase(
-              httpse_urls_redirects_count_.begin());
-      }
-      httpse_urls_redirects_count_.push_back(
-          HTTPSE_REDIRECTS_COUNT_ST(request_identifier, 1));
-  }
-}
-
-std::string HTTPSEverywhereService::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  base::Optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (base::nullopt == json_object || !json_object->is_list()) {
-    return "";
+const HTTPSERules* HTTPSEverywhereService::GetRules(
+    const std::string& domain) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = rules_cache_.Get(domain);
+  if (it != rules_cache_.end()) {
+    return it->second.get();
   }
 
-  base::Value::ConstListView topValues = json_object->GetList();
-  for (auto it = topValues.cbegin(); it != topValues.cend(); ++it) {
-    if (!it->is_dict()) {
-      continue;
-    }
-    const base::DictionaryValue* childTopDictionary = nullptr;
-    it->GetAsDictionary(&childTopDictionary);
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = nullptr;
-    if (childTopDictionary->Get("e", &exclusion)) {
-      const base::ListValue* eValues = nullptr;
-      exclusion->GetAsList(&eValues);
-      if (nullptr != eValues) {
-        for (size_t j = 0; j < eValues->GetSize(); ++j) {
-          const base::Value* pValue = nullptr;
-          if (!eValues->Get(j, &pValue)) {
-            continue;
-          }
-          const base::DictionaryValue* pDictionary = nullptr;
-          pValue->GetAsDictionary(&pDictionary);
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = nullptr;
-          if (!pDictionary->Get("p", &patternValue)) {
-            continue;
-          }
-          std::string pattern;
-          if (!patternValue->GetAsString(&pattern)) {
-            continue;
-          }
-          pattern = CorrecttoRuleToRE2Engine(pattern);
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = nullptr;
-    if (!childTopDictionary->Get("r", &rules)) {
-      return "";
-    }
-    const base::ListValue* rValues = nullptr;
-    rules->GetAsList(&rValues);
-    if (nullptr == rValues) {
-      return "";
+  std::unique_ptr<HTTPSERules> rules;
+  if (index_) {
+    base::StringPiece value = index_->Find(domain);
+    if (!value.empty()) {
+      rules = HTTPSERules::Create(value);
     }
-
-    for (size_t j = 0; j < rValues->GetSize(); ++j) {
-      const base::Value* pValue = nullptr;
-      if (!rValues->Get(j, &pValue)) {
-        continue;
-      }
-      const base::DictionaryValue* pDictionary = nullptr;
-      pValue->GetAsDictionary(&pDictionary);
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = nullptr;
-      if (pDictionary->Get("d", &patternValue)) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = nullptr;
-      const base::Value* to_value = nullptr;
-      if (!pDictionary->Get("f", &from_value) ||
-          !pDictionary->Get("t", &to_value)) {
-        continue;
-      }
-      std::string from, to;
-      if (!from_value->GetAsString(&from) ||
-          !to_value->GetAsString(&to)) {
-        continue;
-      }
-
-      to = CorrecttoRuleToRE2Engine(to);
-      std::string newUrl(originalUrl);
-      RE2 regExp(from);
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
+  } else {
+    std::string value = leveldbGet(level_db_, domain);
+    if (!value.empty()) {
+      rules = HTTPSERules::Create(value);
     }
   }
-  return "";
-}
-
-std::string HTTPSEverywhereService::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
+  it = rules_cache_.Put(domain, std::move(rules));
+  return it->second.get();
 }
 
 void HTTPSEverywhereService::CloseDatabase() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  rules_cache_.Clear();
+  host_cache_.Clear();
+  index_.reset();
   if (level_db_) {
     delete level_db_;
     level_db_ = nullptr;
@@ -8,14 +8,15 @@
 
 #include <memory>
 #include <string>
-#include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
-#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
-#include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_index.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rules.h"
+#include "brave/components/brave_shields/browser/sharded_mru_cache.h"
 
 namespace leveldb {
 class DB;
@@ -31,29 +32,19 @@ extern const char kHTTPSEverywhereComponentName[];
 extern const char kHTTPSEverywhereComponentId[];
 extern const char kHTTPSEverywhereComponentBase64PublicKey[];
 
-struct HTTPSE_REDIRECTS_COUNT_ST {
- public:
-  HTTPSE_REDIRECTS_COUNT_ST(uint64_t request_identifier,
-                            unsigned int redirects):
-    request_identifier_(request_identifier),
-    redirects_(redirects) {
-  }
-
-  uint64_t request_identifier_;
-  unsigned int redirects_;
-};
-
 class HTTPSEverywhereService : public BaseBraveShieldsService,
                          public base::SupportsWeakPtr<HTTPSEverywhereService> {
  public:
   explicit HTTPSEverywhereService(BraveComponent::Delegate* delegate);
   ~HTTPSEverywhereService() override;
-  bool GetHTTPSURL(const GURL* url,
-                   const uint64_t& request_id,
-                   std::string* new_url);
-  bool GetHTTPSURLFromCacheOnly(const GURL* url,
-                                const uint64_t& request_id,
-                                std::string* cached_url);
+  // |redirects_count| is the number of HTTPSE upgrades already applied to
+  // the request, used to break redirect loops.
+  static bool ShouldHTTPSERedirect(int redirects_count);
+
+  bool GetHTTPSURL(const GURL* url, std::string* new_url);
+  // Returns true when the host cache decides the request, with |cached_url|
+  // left empty if no upgrade applies. Safe to call from any thread.
+  bool GetHTTPSURLFromCacheOnly(const GURL* url, std::string* cached_url);
 
  protected:
   bool Init() override;
@@ -61,14 +52,17 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
       const base::FilePath& install_dir,
       const std::string& manifest) override;
 
-  void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
-  bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
-
  private:
   friend class ::HTTPSEverywhereServiceTest;
+
+  // Outcome for hosts whose result does not depend on the rest of the URL
+  enum class HostResult {
+    // No ruleset covers the host
+    kNoRules,
+    // Every URL on the host is upgraded by switching the scheme to https
+    kUpgrade,
+  };
+
   static bool g_ignore_port_for_test_;
   static std::string g_https_everywhere_component_id_;
   static std::string g_https_everywhere_component_base64_public_key_;
@@ -77,14 +71,25 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
       const std::string& component_id,
       const std::string& component_base64_public_key);
 
+  // Drops the port when tests ask for it, so rules match the test server
+  static GURL GetCandidateURL(const GURL& url);
+
   void CloseDatabase();
 
   void InitDB(const base::FilePath& install_dir);
+  bool InitIndex(const base::FilePath& install_dir);
+
+  // Returns the compiled rules for a lookup domain, or nullptr when the
+  // database has none
+  const HTTPSERules* GetRules(const std::string& domain);
 
-  base::Lock httpse_get_urls_redirects_count_mutex_;
-  std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
-  HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  // Read on the UI thread and written on the HTTPSE task runner
+  ShardedMRUCache<HostResult> host_cache_;
+  // Components that predate the index still ship the leveldb database
+  std::unique_ptr<HTTPSEIndex> index_;
   leveldb::DB* level_db_;
+  // Keyed by lookup domain, nullptr entries record domains without rules
+  base::MRUCache<std::string, std::unique_ptr<HTTPSERules>> rules_cache_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   DISALLOW_COPY_AND_ASSIGN(HTTPSEverywhereService);
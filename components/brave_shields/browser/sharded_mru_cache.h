@@ -0,0 +1,111 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHARDED_MRU_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHARDED_MRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+// MRU cache keyed by string that can be used from several threads at once.
+// Entries are spread over independently locked shards, so lookups of
+// different keys rarely contend. Each shard evicts on its own, which makes
+// the total size approximate.
+template <typename Value>
+class ShardedMRUCache {
+ public:
+  static const size_t kDefaultSize = 4096;
+
+  explicit ShardedMRUCache(size_t size = kDefaultSize)
+      : hits_(0),
+        misses_(0) {
+    const size_t shard_size = std::max<size_t>(1, size / kShardCount);
+    for (size_t i = 0; i < kShardCount; i++) {
+      shards_.push_back(std::make_unique<Shard>(shard_size));
+    }
+  }
+
+  ~ShardedMRUCache() = default;
+
+  void Put(std::string key, Value value) {
+    Shard* shard = GetShard(key);
+    base::AutoLock lock(shard->lock);
+    shard->data.Put(std::move(key), std::move(value));
+  }
+
+  bool Get(const std::string& key, Value* value) {
+    return GetIf(key, value, [](const Value&) { return true; });
+  }
+
+  // Same as Get, but an entry rejected by |is_valid| is erased and
+  // counted as a miss
+  template <typename Predicate>
+  bool GetIf(const std::string& key, Value* value, Predicate is_valid) {
+    Shard* shard = GetShard(key);
+    {
+      base::AutoLock lock(shard->lock);
+      auto it = shard->data.Get(key);
+      if (it != shard->data.end()) {
+        if (is_valid(it->second)) {
+          *value = it->second;
+          hits_.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        shard->data.Erase(it);
+      }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      base::AutoLock lock(shard->lock);
+      shard->data.Clear();
+    }
+  }
+
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  static const size_t kShardCount = 16;
+
+  struct Shard {
+    explicit Shard(size_t size) : data(size) {}
+
+    base::Lock lock;
+    base::MRUCache<std::string, Value> data;
+  };
+
+  Shard* GetShard(const std::string& key) {
+    return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> hits_;
+  std::atomic<uint64_t> misses_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedMRUCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHARDED_MRU_CACHE_H_
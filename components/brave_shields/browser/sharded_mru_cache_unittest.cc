@@ -0,0 +1,72 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "brave/components/brave_shields/browser/sharded_mru_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+TEST(ShardedMRUCacheTest, Operations) {
+  ShardedMRUCache<int> cache;
+  int value = 0;
+
+  EXPECT_FALSE(cache.Get("example.com", &value));
+  cache.Put("example.com", 1);
+  cache.Put("example.org", 2);
+
+  ASSERT_TRUE(cache.Get("example.com", &value));
+  EXPECT_EQ(value, 1);
+  ASSERT_TRUE(cache.Get("example.org", &value));
+  EXPECT_EQ(value, 2);
+  EXPECT_EQ(cache.hits(), 2u);
+  EXPECT_EQ(cache.misses(), 1u);
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get("example.com", &value));
+  EXPECT_EQ(cache.misses(), 2u);
+}
+
+TEST(ShardedMRUCacheTest, GetIf) {
+  ShardedMRUCache<int> cache;
+  int value = 0;
+
+  cache.Put("example.com", 1);
+  ASSERT_TRUE(cache.GetIf("example.com", &value,
+                          [](int cached) { return cached == 1; }));
+  EXPECT_EQ(value, 1);
+
+  // A rejected entry counts as a miss and is gone for later lookups
+  EXPECT_FALSE(cache.GetIf("example.com", &value,
+                           [](int cached) { return cached == 2; }));
+  EXPECT_FALSE(cache.Get("example.com", &value));
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 2u);
+}
+
+TEST(ShardedMRUCacheTest, MaxSize) {
+  // 16 shards of one entry each
+  ShardedMRUCache<int> cache(16);
+  for (int i = 0; i < 1000; i++) {
+    cache.Put(base::NumberToString(i), i);
+  }
+
+  size_t cached = 0;
+  int value = 0;
+  for (int i = 0; i < 1000; i++) {
+    if (cache.Get(base::NumberToString(i), &value)) {
+      cached++;
+    }
+  }
+  EXPECT_LE(cached, 16u);
+
+  // The most recent entry of its shard always survives
+  EXPECT_TRUE(cache.Get("999", &value));
+  EXPECT_EQ(value, 999);
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,68 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+// static
+ShieldsSettingsSnapshot ShieldsSettingsSnapshot::Create(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin) {
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.brave_shields_enabled = GetBraveShieldsEnabled(map, tab_origin);
+  snapshot.allow_ads =
+      GetAdControlType(map, tab_origin) == ControlType::ALLOW;
+  snapshot.https_everywhere_enabled =
+      GetHTTPSEverywhereEnabled(map, tab_origin);
+  snapshot.allow_referrers = AllowReferrers(map, tab_origin);
+  return snapshot;
+}
+
+ShieldsSettingsSnapshotCache::ShieldsSettingsSnapshotCache(
+    HostContentSettingsMap* map,
+    size_t size)
+    : map_(map),
+      snapshots_(size) {
+  map_->AddObserver(this);
+}
+
+ShieldsSettingsSnapshotCache::~ShieldsSettingsSnapshotCache() {
+  map_->RemoveObserver(this);
+}
+
+ShieldsSettingsSnapshot ShieldsSettingsSnapshotCache::Get(
+    const GURL& tab_origin,
+    bool is_navigation) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!is_navigation) {
+    auto it = snapshots_.Get(tab_origin);
+    if (it != snapshots_.end()) {
+      return it->second;
+    }
+  }
+
+  ShieldsSettingsSnapshot snapshot =
+      ShieldsSettingsSnapshot::Create(map_.get(), tab_origin);
+  snapshots_.Put(tab_origin, snapshot);
+  return snapshot;
+}
+
+void ShieldsSettingsSnapshotCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  // Shields settings are all stored as plugin resources
+  if (content_type == ContentSettingsType::PLUGINS) {
+    snapshots_.Clear();
+  }
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,66 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+
+// The shields settings the network stack needs for requests made by a site.
+// Every field is a separate content settings lookup, so the values are read
+// once per site and shared by all of its requests.
+struct ShieldsSettingsSnapshot {
+  static ShieldsSettingsSnapshot Create(HostContentSettingsMap* map,
+                                        const GURL& tab_origin);
+
+  bool brave_shields_enabled : 1;
+  bool allow_ads : 1;
+  bool https_everywhere_enabled : 1;
+  bool allow_referrers : 1;
+};
+
+// Keeps the snapshots of recently used sites for a profile. A snapshot is
+// refreshed by every top-level navigation to its site and all of them are
+// dropped when any content setting changes.
+class ShieldsSettingsSnapshotCache : public content_settings::Observer {
+ public:
+  static const size_t kDefaultSize = 128;
+
+  explicit ShieldsSettingsSnapshotCache(HostContentSettingsMap* map,
+                                        size_t size = kDefaultSize);
+  ~ShieldsSettingsSnapshotCache() override;
+
+  // |is_navigation| forces a fresh read for main frame requests.
+  ShieldsSettingsSnapshot Get(const GURL& tab_origin, bool is_navigation);
+
+ private:
+  // content_settings::Observer overrides:
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier) override;
+
+  // Held so the observer can still be removed after profile shutdown
+  scoped_refptr<HostContentSettingsMap> map_;
+  base::MRUCache<GURL, ShieldsSettingsSnapshot> snapshots_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshotCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_SHIELDS_SETTINGS_SNAPSHOT_H_
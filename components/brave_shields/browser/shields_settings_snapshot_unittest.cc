@@ -0,0 +1,81 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/shields_settings_snapshot.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::ControlType;
+using brave_shields::ShieldsSettingsSnapshot;
+using brave_shields::ShieldsSettingsSnapshotCache;
+
+class ShieldsSettingsSnapshotTest : public testing::Test {
+ public:
+  ShieldsSettingsSnapshotTest() = default;
+  ~ShieldsSettingsSnapshotTest() override = default;
+
+  void SetUp() override { profile_ = std::make_unique<TestingProfile>(); }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsSnapshotTest);
+};
+
+TEST_F(ShieldsSettingsSnapshotTest, Create) {
+  const GURL origin("https://brave.com");
+  ShieldsSettingsSnapshot snapshot =
+      ShieldsSettingsSnapshot::Create(map(), origin);
+  EXPECT_TRUE(snapshot.brave_shields_enabled);
+  EXPECT_FALSE(snapshot.allow_ads);
+  EXPECT_TRUE(snapshot.https_everywhere_enabled);
+  EXPECT_FALSE(snapshot.allow_referrers);
+
+  brave_shields::SetBraveShieldsEnabled(map(), false, origin);
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, origin);
+  snapshot = ShieldsSettingsSnapshot::Create(map(), origin);
+  EXPECT_FALSE(snapshot.brave_shields_enabled);
+  EXPECT_TRUE(snapshot.allow_ads);
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, CacheInvalidation) {
+  const GURL origin("https://brave.com");
+  ShieldsSettingsSnapshotCache cache(map());
+  EXPECT_TRUE(cache.Get(origin, false).brave_shields_enabled);
+
+  // Changing any shields setting drops cached snapshots
+  brave_shields::SetBraveShieldsEnabled(map(), false, origin);
+  EXPECT_FALSE(cache.Get(origin, false).brave_shields_enabled);
+
+  // Other sites are unaffected
+  EXPECT_TRUE(cache.Get(GURL("https://example.com"), false)
+                  .brave_shields_enabled);
+}
+
+TEST_F(ShieldsSettingsSnapshotTest, CacheNavigationRefresh) {
+  const GURL origin("https://brave.com");
+  ShieldsSettingsSnapshotCache cache(map());
+  EXPECT_FALSE(cache.Get(origin, false).allow_ads);
+
+  // Bypass the observer to check that navigations read settings again
+  map()->RemoveObserver(&cache);
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, origin);
+  EXPECT_FALSE(cache.Get(origin, false).allow_ads);
+  EXPECT_TRUE(cache.Get(origin, true).allow_ads);
+  EXPECT_TRUE(cache.Get(origin, false).allow_ads);
+  map()->AddObserver(&cache);
+}
@@ -292,7 +292,7 @@ declare namespace chrome.braveShields {
     generichide: boolean
   }
   const urlCosmeticResources: (url: string, callback: (resources: UrlSpecificResources) => void) => void
-  const hiddenClassIdSelectors: (classes: string[], ids: string[], exceptions: string[], callback: (selectors: string[], forceHideSelectors: string[]) => void) => void
+  const hiddenClassIdSelectors: (tabId: number, frameId: number, classes: string[], ids: string[], exceptions: string[], callback: (selectors: string[], forceHideSelectors: string[]) => void) => void
 
   type BraveShieldsViewPreferences = {
     showAdvancedView: boolean
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
 #include "brave/base/containers/utils.h"
 
 namespace bat_ledger {
@@ -151,78 +152,145 @@ void BatLedgerClientMojoBridge::PublisherListNormalized(
 
 void BatLedgerClientMojoBridge::SetBooleanState(const std::string& name,
                                                bool value) {
+  state_cache_[name] = base::Value(value);
   bat_ledger_client_->SetBooleanState(name, value);
 }
 
 bool BatLedgerClientMojoBridge::GetBooleanState(const std::string& name) const {
-  bool value;
-  bat_ledger_client_->GetBooleanState(name, &value);
+  const base::Value* cached = GetCachedState(name, base::Value::Type::BOOLEAN);
+  if (cached) {
+    return cached->GetBool();
+  }
+
+  bool value = false;
+  if (bat_ledger_client_->GetBooleanState(name, &value)) {
+    state_cache_[name] = base::Value(value);
+  }
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetIntegerState(const std::string& name,
                                                int value) {
+  state_cache_[name] = base::Value(value);
   bat_ledger_client_->SetIntegerState(name, value);
 }
 
 int BatLedgerClientMojoBridge::GetIntegerState(const std::string& name) const {
-  int value;
-  bat_ledger_client_->GetIntegerState(name, &value);
+  const base::Value* cached = GetCachedState(name, base::Value::Type::INTEGER);
+  if (cached) {
+    return cached->GetInt();
+  }
+
+  int value = 0;
+  if (bat_ledger_client_->GetIntegerState(name, &value)) {
+    state_cache_[name] = base::Value(value);
+  }
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetDoubleState(const std::string& name,
                                               double value) {
+  state_cache_[name] = base::Value(value);
   bat_ledger_client_->SetDoubleState(name, value);
 }
 
 double BatLedgerClientMojoBridge::GetDoubleState(
     const std::string& name) const {
-  double value;
-  bat_ledger_client_->GetDoubleState(name, &value);
+  const base::Value* cached = GetCachedState(name, base::Value::Type::DOUBLE);
+  if (cached) {
+    return cached->GetDouble();
+  }
+
+  double value = 0.0;
+  if (bat_ledger_client_->GetDoubleState(name, &value)) {
+    state_cache_[name] = base::Value(value);
+  }
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetStringState(const std::string& name,
                               const std::string& value) {
+  state_cache_[name] = base::Value(value);
   bat_ledger_client_->SetStringState(name, value);
 }
 
 std::string BatLedgerClientMojoBridge::
 GetStringState(const std::string& name) const {
+  const base::Value* cached = GetCachedState(name, base::Value::Type::STRING);
+  if (cached) {
+    return cached->GetString();
+  }
+
   std::string value;
-  bat_ledger_client_->GetStringState(name, &value);
+  if (bat_ledger_client_->GetStringState(name, &value)) {
+    state_cache_[name] = base::Value(value);
+  }
   return value;
 }
 
+// 64-bit values are stored as strings in prefs, so we do the same
 void BatLedgerClientMojoBridge::SetInt64State(const std::string& name,
                                              int64_t value) {
+  state_cache_[name] = base::Value(base::NumberToString(value));
   bat_ledger_client_->SetInt64State(name, value);
 }
 
 int64_t BatLedgerClientMojoBridge::GetInt64State(
     const std::string& name) const {
-  int64_t value;
-  bat_ledger_client_->GetInt64State(name, &value);
+  const base::Value* cached = GetCachedState(name, base::Value::Type::STRING);
+  int64_t value = 0;
+  if (cached && base::StringToInt64(cached->GetString(), &value)) {
+    return value;
+  }
+
+  if (bat_ledger_client_->GetInt64State(name, &value)) {
+    state_cache_[name] = base::Value(base::NumberToString(value));
+  }
   return value;
 }
 
 void BatLedgerClientMojoBridge::SetUint64State(const std::string& name,
                                               uint64_t value) {
+  state_cache_[name] = base::Value(base::NumberToString(value));
   bat_ledger_client_->SetUint64State(name, value);
 }
 
 uint64_t BatLedgerClientMojoBridge::GetUint64State(
     const std::string& name) const {
-  uint64_t value;
-  bat_ledger_client_->GetUint64State(name, &value);
+  const base::Value* cached = GetCachedState(name, base::Value::Type::STRING);
+  uint64_t value = 0;
+  if (cached && base::StringToUint64(cached->GetString(), &value)) {
+    return value;
+  }
+
+  if (bat_ledger_client_->GetUint64State(name, &value)) {
+    state_cache_[name] = base::Value(base::NumberToString(value));
+  }
   return value;
 }
 
+void BatLedgerClientMojoBridge::ClearStateCache() {
+  state_cache_.clear();
+  encrypted_state_cache_.clear();
+}
+
 void BatLedgerClientMojoBridge::ClearState(const std::string& name) {
+  state_cache_.erase(name);
+  encrypted_state_cache_.erase(name);
   bat_ledger_client_->ClearState(name);
 }
 
+const base::Value* BatLedgerClientMojoBridge::GetCachedState(
+    const std::string& name,
+    const base::Value::Type type) const {
+  const auto it = state_cache_.find(name);
+  if (it == state_cache_.end() || it->second.type() != type) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
 bool BatLedgerClientMojoBridge::GetBooleanOption(
     const std::string& name) const {
   bool value;
@@ -374,15 +442,30 @@ void BatLedgerClientMojoBridge::DeleteLog(
 bool BatLedgerClientMojoBridge::SetEncryptedStringState(
     const std::string& name,
     const std::string& value) {
+  // the plain value is stored under the same pref as the encrypted one
+  state_cache_.erase(name);
+
   bool success;
   bat_ledger_client_->SetEncryptedStringState(name, value, &success);
+  if (success) {
+    encrypted_state_cache_[name] = value;
+  } else {
+    encrypted_state_cache_.erase(name);
+  }
   return success;
 }
 
 std::string BatLedgerClientMojoBridge::GetEncryptedStringState(
     const std::string& name) {
+  const auto it = encrypted_state_cache_.find(name);
+  if (it != encrypted_state_cache_.end()) {
+    return it->second;
+  }
+
   std::string value;
-  bat_ledger_client_->GetEncryptedStringState(name, &value);
+  if (bat_ledger_client_->GetEncryptedStringState(name, &value)) {
+    encrypted_state_cache_[name] = value;
+  }
   return value;
 }
 
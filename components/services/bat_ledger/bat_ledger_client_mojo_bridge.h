@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/values.h"
 #include "bat/ledger/ledger_client.h"
 #include "brave/components/services/bat_ledger/public/interfaces/bat_ledger.mojom.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
@@ -31,6 +32,9 @@ class BatLedgerClientMojoBridge :
   BatLedgerClientMojoBridge& operator=(
       const BatLedgerClientMojoBridge&) = delete;
 
+  // Drops every cached state value, so later reads go to the browser again
+  void ClearStateCache();
+
   void OnReconcileComplete(
       const ledger::type::Result result,
       ledger::type::ContributionInfoPtr contribution) override;
@@ -127,7 +131,19 @@ class BatLedgerClientMojoBridge :
  private:
   bool Connected() const;
 
+  const base::Value* GetCachedState(
+      const std::string& name,
+      const base::Value::Type type) const;
+
   mojo::AssociatedRemote<mojom::BatLedgerClient> bat_ledger_client_;
+
+  // Once the ledger is initialized its state is only changed through this
+  // bridge, so we keep a write-through copy and every state read after the
+  // first one doesn't need a sync IPC to the browser. The browser may still
+  // write prefs before that (see PrepareLedgerEnvForTesting), which is why
+  // BatLedgerImpl::Initialize() clears the copy.
+  mutable std::map<std::string, base::Value> state_cache_;
+  std::map<std::string, std::string> encrypted_state_cache_;
 };
 
 }  // namespace bat_ledger
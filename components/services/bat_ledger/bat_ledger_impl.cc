@@ -43,6 +43,9 @@ void BatLedgerImpl::OnInitialize(
 void BatLedgerImpl::Initialize(
     const bool execute_create_script,
     InitializeCallback callback) {
+  // The browser can write ledger prefs directly up to this point
+  bat_ledger_client_mojo_bridge_->ClearStateCache();
+
   auto* holder = new CallbackHolder<InitializeCallback>(
       AsWeakPtr(), std::move(callback));
   ledger_->Initialize(
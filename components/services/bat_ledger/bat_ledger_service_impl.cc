@@ -58,6 +58,12 @@ void BatLedgerServiceImpl::SetShortRetries(bool short_retries) {
   ledger::short_retries = short_retries;
 }
 
+void BatLedgerServiceImpl::SetContributionQueueConcurrency(
+    const int32_t concurrency) {
+  DCHECK(!initialized_ || testing());
+  ledger::contribution_queue_concurrency = concurrency;
+}
+
 void BatLedgerServiceImpl::SetTesting() {
   ledger::is_testing = true;
 }
@@ -38,6 +38,7 @@ class BatLedgerServiceImpl : public mojom::BatLedgerService {
   void SetDebug(bool isDebug) override;
   void SetReconcileInterval(const int32_t interval) override;
   void SetShortRetries(bool short_retries) override;
+  void SetContributionQueueConcurrency(const int32_t concurrency) override;
   void SetTesting() override;
 
   void GetEnvironment(GetEnvironmentCallback callback) override;
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+# Copyright (c) 2020 The Brave Authors. All rights reserved.
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this file,
+# You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+"""Builds the memory mapped HTTPS Everywhere index read by HTTPSEIndex.
+
+The input is a JSON object mapping lookup domains (as produced for the old
+leveldb database, e.g. "com.example.*") to their rulesets. Rulesets may be
+given either as JSON strings or as JSON lists.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+from io import open
+
+
+MAGIC = b'HTTPSEIX'
+VERSION = 1
+HEADER_SIZE = len(MAGIC) + 8
+ENTRY_SIZE = 16
+
+
+def build_index(rules):
+    entries = []
+    for key, value in rules.items():
+        if not isinstance(value, str):
+            value = json.dumps(value, separators=(',', ':'))
+        entries.append((key.encode('utf-8'), value.encode('utf-8')))
+    entries.sort()
+
+    data_offset = HEADER_SIZE + ENTRY_SIZE * len(entries)
+    table = []
+    data = []
+    for key, value in entries:
+        table.append(struct.pack('<II', data_offset, len(key)))
+        data.append(key)
+        data_offset += len(key)
+        table.append(struct.pack('<II', data_offset, len(value)))
+        data.append(value)
+        data_offset += len(value)
+
+    if data_offset > 0xFFFFFFFF:
+        raise ValueError('HTTPSE index exceeds 4GB')
+
+    header = MAGIC + struct.pack('<II', VERSION, len(entries))
+    return header + b''.join(table) + b''.join(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('input', help='JSON file of domain to ruleset')
+    parser.add_argument('output', help='index file to write')
+    args = parser.parse_args()
+
+    with open(args.input, encoding='utf-8') as f:
+        rules = json.load(f)
+
+    with open(args.output, 'wb') as f:
+        f.write(build_index(rules))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())